@@ -0,0 +1,12 @@
+// Benchmarks only: `npm run bench`. Kept out of the default test run because they take
+// minutes at the larger sizes and their timings mean nothing on a loaded machine.
+const base = require('./jest.config');
+
+module.exports = {
+  ...base,
+  roots: ['<rootDir>/tests/benchmarks'],
+  testMatch: ['**/*.bench.ts'],
+  setupFilesAfterEnv: [...base.setupFilesAfterEnv, '<rootDir>/tests/benchmarks/setup.ts'],
+  testTimeout: 30 * 60 * 1000,
+  maxWorkers: 1,
+};
@@ -1,20 +1,36 @@
-import { ipcMain, dialog, shell } from 'electron';
+import { app, ipcMain, dialog, shell } from 'electron';
 import * as path from 'path';
 import * as fs from 'fs/promises';
-import { Account, Settings } from '../../shared/types';
-import { AccountStorage } from '../services/accountStorage';
+import { Account, Settings, JobProgress, ClientResources } from '../../shared/types';
+import { AccountStorage, AccountBatchMode } from '../services/accountStorage';
 import { SettingsManager } from '../services/settingsManager';
 import { GameProcessManager } from '../services/gameProcessManager';
 import { BatchFileScanner } from '../services/batchFileScanner';
+import { BatchFileIndex } from '../services/batchFileIndex';
 import { WebViewManager } from '../services/webviewManager';
+import { processSnapshot } from '../services/processSnapshotService';
+import { LaunchScheduler } from '../services/launchScheduler';
+import { ResourceMonitor } from '../services/resourceMonitor';
+import { StateDeltaPublisher } from '../services/stateDeltaPublisher';
+import { OperationJobs } from '../services/operationJobs';
 import { mainWindow } from '../main';
-import { logger } from '../services/loggingService';
+import { logger, LogLevel } from '../services/loggingService';
+import { startupProfile } from '../services/startupProfile';
+import { metrics } from '../services/performanceMetrics';
+import { workerPool } from '../services/workerPool';
 import { setupLoggingHandlers } from './loggingHandlers';
+import { setupPerformanceHandlers } from './performanceHandlers';
 
 let accountStorage: AccountStorage;
 let settingsManager: SettingsManager;
 let gameProcessManager: GameProcessManager;
 let webViewManager: WebViewManager;
+let launchScheduler: LaunchScheduler;
+let resourceMonitor: ResourceMonitor;
+let batchFileIndex: BatchFileIndex;
+let stateDeltaPublisher: StateDeltaPublisher;
+let operationJobs: OperationJobs;
+let activeScan: AbortController | null = null;
 
 async function validateGameFolder(folderPath: string): Promise<boolean> {
   try {
@@ -58,29 +74,59 @@ async function validateGameFolder(folderPath: string): Promise<boolean> {
   }
 }
 
+// Startup work that is not needed for the first paint: process discovery and partition
+// cleanup. Called once the main window is showing.
+let deferredStartupDone = false;
+export function runDeferredStartup() {
+  if (deferredStartupDone) {
+    return;
+  }
+  deferredStartupDone = true;
+  startupProfile.mark('deferred-started');
+
+  void gameProcessManager
+    .scanExistingProcesses()
+    .then(() => startupProfile.mark('processes-scanned'));
+  void accountStorage
+    .whenReady()
+    .then(() =>
+      webViewManager.collectStalePartitions((id) => !!accountStorage.getAccountById(id))
+    );
+}
+
 export function setupIpcHandlers() {
   accountStorage = new AccountStorage();
-  settingsManager = new SettingsManager();
+  settingsManager = SettingsManager.getInstance();
   gameProcessManager = new GameProcessManager(settingsManager);
   webViewManager = new WebViewManager();
+  resourceMonitor = new ResourceMonitor(gameProcessManager);
+  launchScheduler = new LaunchScheduler(gameProcessManager, resourceMonitor);
+  operationJobs = new OperationJobs((progress) => {
+    metrics.increment('ipc.jobProgress');
+    mainWindow?.webContents.send('job-progress', progress);
+  });
+  batchFileIndex = new BatchFileIndex(path.join(app.getPath('userData'), 'batch-index.json'));
 
   // Setup logging handlers
   setupLoggingHandlers();
+  setupPerformanceHandlers();
 
   logger.info('Application started', { version: '1.2.0' }, 'MAIN');
+  accountStorage.whenReady().then(() => startupProfile.mark('accounts-ready'));
 
+  // Corrupted character names are reported once when the accounts file loads, and the
+  // count is a STORAGE debug entry in getAccounts, so this hot path logs nothing itself
   ipcMain.handle('get-accounts', async () => {
-    const accounts = await accountStorage.getAccounts();
+    return await accountStorage.getAccounts();
+  });
 
-    // DIAGNOSTIC: Log when accounts are requested
-    console.log(`\n📋 GET-ACCOUNTS: Returning ${accounts.length} accounts`);
-    accounts.forEach((account) => {
-      if (account.characterName && account.characterName.includes('?')) {
-        console.error(`📋 ⚠️ ${account.login} has corrupted character: "${account.characterName}"`);
-      }
-    });
+  // Cached roster for the first paint; null once the accounts file is loaded
+  ipcMain.handle('get-roster-snapshot', async () => {
+    return await accountStorage.getRosterSnapshot();
+  });
 
-    return accounts;
+  ipcMain.handle('get-account-changes', async (_, since: number) => {
+    return await accountStorage.getAccountChanges(since || 0);
   });
 
   ipcMain.handle('save-account', async (_, account: Account) => {
@@ -89,6 +135,8 @@ export function setupIpcHandlers() {
 
   ipcMain.handle('delete-account', async (_, id: string) => {
     await accountStorage.deleteAccount(id);
+    webViewManager.closeWebView(id);
+    void webViewManager.collectStalePartitions((id) => !!accountStorage.getAccountById(id));
     return { success: true };
   });
 
@@ -106,15 +154,9 @@ export function setupIpcHandlers() {
     return await settingsManager.getSettings();
   });
 
+  // GameProcessManager re-tunes monitoring itself through its settings subscription
   ipcMain.handle('save-settings', async (_, settings: Settings) => {
-    const result = await settingsManager.saveSettings(settings);
-
-    // Update process monitoring performance if settings changed
-    if (gameProcessManager && settings.processMonitoringMode) {
-      gameProcessManager.updatePerformanceSettings();
-    }
-
-    return result;
+    return await settingsManager.saveSettings(settings);
   });
 
   ipcMain.handle('select-game-folder', async () => {
@@ -146,8 +188,7 @@ export function setupIpcHandlers() {
   });
 
   ipcMain.handle('launch-game', async (_, accountIds: string[]) => {
-    console.log('\n========== LAUNCH-GAME HANDLER DIAGNOSTIC ==========');
-    console.log('📨 Received accountIds:', accountIds);
+    logger.debug(`launch-game received ${accountIds.length} account ids`, { accountIds }, 'LAUNCH');
 
     const settings = await settingsManager.getSettings();
     if (!settings.gamePath) {
@@ -155,41 +196,38 @@ export function setupIpcHandlers() {
     }
 
     // Fetch accounts fresh from storage
-    const accounts = await accountStorage.getAccounts();
-    console.log(`📨 Fetched ${accounts.length} accounts from storage`);
-
-    const accountsToLaunch = accounts.filter((acc) => accountIds.includes(acc.id));
-
-    // DIAGNOSTIC: Check character names from storage
-    console.log(`📨 Accounts to launch: ${accountsToLaunch.length}`);
-    accountsToLaunch.forEach((account, index) => {
-      console.log(`\n📨 Account ${index + 1}/${accountsToLaunch.length}:`);
-      console.log(`  Login: ${account.login}`);
-      console.log(`  ID: ${account.id}`);
-
-      if (account.characterName) {
-        console.log(`  Character name: "${account.characterName}"`);
-        console.log(`  Character name type: ${typeof account.characterName}`);
-        console.log(`  Character name length: ${account.characterName.length}`);
-        console.log(`  Contains '?': ${account.characterName.includes('?')}`);
-        console.log(`  UTF-8 bytes:`, Buffer.from(account.characterName, 'utf8'));
-        console.log(
-          `  Char codes:`,
-          [...account.characterName]
-            .map((c) => `${c}(U+${c.charCodeAt(0).toString(16).toUpperCase().padStart(4, '0')})`)
-            .join(' ')
+    await accountStorage.whenReady();
+    const accountsToLaunch = accountStorage.getAccountsByIds(accountIds);
+
+    // Character name encoding diagnostics, only built when LAUNCH debug is on
+    if (logger.isEnabled(LogLevel.DEBUG, 'LAUNCH')) {
+      accountsToLaunch.forEach((account) => {
+        const name = account.characterName;
+        logger.debug(
+          `Launching ${account.login}${name ? ` as "${name}"` : ''}`,
+          name
+            ? {
+                id: account.id,
+                length: name.length,
+                utf8: Buffer.from(name, 'utf8').toString('hex'),
+                charCodes: [...name]
+                  .map((c) => `U+${c.charCodeAt(0).toString(16).toUpperCase().padStart(4, '0')}`)
+                  .join(' '),
+              }
+            : { id: account.id },
+          'LAUNCH'
+        );
+      });
+    }
+    accountsToLaunch.forEach((account) => {
+      if (account.characterName?.includes('?')) {
+        logger.warn(
+          `Character name of ${account.login} is already corrupted in storage`,
+          { characterName: account.characterName },
+          'LAUNCH'
         );
-
-        if (account.characterName.includes('?')) {
-          console.error(`  ⚠️ CHARACTER ALREADY CORRUPTED IN STORAGE!`);
-        } else {
-          console.log(`  ✅ Character name is intact`);
-        }
-      } else {
-        console.log(`  Character name: not specified`);
       }
     });
-    console.log('==================================================\n');
 
     // Validate delay is within acceptable range
     const delay = Math.max(10, Math.min(60, settings.launchDelay || 15));
@@ -199,31 +237,33 @@ export function setupIpcHandlers() {
       console.log('Individual launch - no delay applied');
       await gameProcessManager.launchGame(accountsToLaunch[0], settings.gamePath);
     } else if (accountsToLaunch.length > 1) {
-      // Group launch - apply delay between launches
-      console.log(`Group launch of ${accountsToLaunch.length} clients with ${delay}s delay`);
-
-      for (let i = 0; i < accountsToLaunch.length; i++) {
-        if (i > 0) {
-          console.log(`Waiting ${delay} seconds before launching ${accountsToLaunch[i].login}...`);
-          await new Promise((resolve) => setTimeout(resolve, delay * 1000));
-        }
-
-        const account = accountsToLaunch[i];
-        console.log(`🚀 Launching ${account.login} (${i + 1}/${accountsToLaunch.length})`);
-        await gameProcessManager.launchGame(account, settings.gamePath);
-        console.log(`✅ Launch completed for ${account.login} - PID associated`);
-
-        // Additional delay before next launch to ensure processes are stable
-        if (i < accountsToLaunch.length - 1) {
-          console.log(`⏱️ Waiting additional 2 seconds for process stabilization...`);
-          await new Promise((resolve) => setTimeout(resolve, 2000));
-        }
-      }
+      // Group launch - runs in the background, paced on client readiness with delay as upper bound
+      const maxConcurrent = settings.maxConcurrentLaunches || 2;
+      console.log(
+        `Group launch of ${accountsToLaunch.length} clients, ${maxConcurrent} at a time, up to ${delay}s readiness wait`
+      );
+      const jobId = operationJobs.create('launch', accountsToLaunch.length);
+      launchScheduler.start(jobId, accountsToLaunch, settings.gamePath, {
+        maxConcurrent,
+        launchDelay: delay,
+        cpuLimit: settings.launchCpuLimit || 85,
+        memoryLimit: settings.launchMemoryLimit || 90,
+      });
+      return { success: true, jobId };
     }
 
     return { success: true };
   });
 
+  ipcMain.handle('cancel-launch', async (_, jobId?: string) => {
+    return { success: launchScheduler.cancel(jobId) };
+  });
+
+  // Resolves with the final state of a launch or close job, or null for unknown ids
+  ipcMain.handle('await-job', async (_, jobId: string, timeoutMs?: number) => {
+    return operationJobs.wait(jobId, timeoutMs);
+  });
+
   ipcMain.handle('close-game', async (_, accountIds: string[]) => {
     console.log(`📨 IPC close-game received accountIds: [${accountIds.join(', ')}]`);
 
@@ -231,12 +271,38 @@ export function setupIpcHandlers() {
       if (accountIds.length === 1) {
         console.log(`📨 Single close for: ${accountIds[0]}`);
         await gameProcessManager.closeGame(accountIds[0]);
-      } else {
-        console.log(`📨 Multiple close for: [${accountIds.join(', ')}]`);
-        await gameProcessManager.closeMultipleGames(accountIds);
+        console.log(`📨 IPC close-game completed successfully`);
+        return { success: true };
       }
-      console.log(`📨 IPC close-game completed successfully`);
-      return { success: true };
+
+      // Group close - runs as a job; the renderer follows one progress stream for all clients
+      console.log(`📨 Multiple close for: [${accountIds.join(', ')}]`);
+      const jobId = operationJobs.create('close', accountIds.length);
+      operationJobs.report(jobId, {
+        active: accountIds.map((id) => accountStorage.getAccountById(id)?.login ?? id),
+      });
+      gameProcessManager
+        .closeMultipleGames(accountIds)
+        .then((failed) => {
+          operationJobs.report(jobId, {
+            state: 'completed',
+            done: accountIds.length - failed,
+            failed,
+            pending: 0,
+            active: [],
+          });
+        })
+        .catch((error: any) => {
+          console.error(`📨 Group close failed:`, error);
+          operationJobs.report(jobId, {
+            state: 'completed',
+            failed: accountIds.length,
+            pending: 0,
+            active: [],
+            error: error.message,
+          });
+        });
+      return { success: true, jobId };
     } catch (error: any) {
       console.error(`📨 IPC close-game failed:`, error);
       return { success: false, error: error.message };
@@ -250,14 +316,72 @@ export function setupIpcHandlers() {
     });
 
     if (!result.canceled && result.filePaths.length > 0) {
-      const scanner = new BatchFileScanner();
-      const accounts = await scanner.scanFolder(result.filePaths[0]);
-      return { success: true, accounts };
+      activeScan?.abort();
+      const controller = new AbortController();
+      activeScan = controller;
+
+      const settings = await settingsManager.getSettings();
+      const scanner = new BatchFileScanner(batchFileIndex);
+      let pending: Partial<Account>[] = [];
+      let flushTimer: NodeJS.Timeout | null = null;
+
+      // Stream found accounts in small batches rather than one IPC message per file
+      const sendProgress = (done: boolean) => {
+        const stats = scanner.getLastScanStats();
+        mainWindow?.webContents.send('scan-progress', {
+          accounts: pending,
+          found: stats.accountsFound,
+          directoriesScanned: stats.directoriesScanned,
+          done,
+          cancelled: stats.cancelled,
+        });
+        pending = [];
+      };
+
+      const accounts = await scanner.scanFolder(result.filePaths[0], {
+        maxDepth: settings.scanMaxDepth,
+        maxFiles: settings.scanMaxFiles,
+        signal: controller.signal,
+        onAccounts: (found) => {
+          pending.push(...found);
+          if (!flushTimer) {
+            flushTimer = setTimeout(() => {
+              flushTimer = null;
+              sendProgress(false);
+            }, 100);
+          }
+        },
+      });
+
+      if (flushTimer) {
+        clearTimeout(flushTimer);
+      }
+      sendProgress(true);
+
+      if (activeScan === controller) {
+        activeScan = null;
+      }
+      const diff = scanner.getLastScanDiff();
+      if (diff) {
+        console.log(
+          `📂 Scan: ${diff.added.length} added, ${diff.modified.length} modified, ` +
+            `${diff.removed.length} removed, ${diff.unchanged} unchanged`
+        );
+      }
+      return { success: true, accounts, diff, cancelled: controller.signal.aborted };
     }
 
     return { success: false, accounts: [] };
   });
 
+  ipcMain.handle('cancel-scan', async () => {
+    if (!activeScan) {
+      return { success: false };
+    }
+    activeScan.abort();
+    return { success: true };
+  });
+
   ipcMain.handle('export-accounts', async (_, format: 'json' | 'csv') => {
     const result = await dialog.showSaveDialog({
       title: 'Export Accounts',
@@ -269,8 +393,7 @@ export function setupIpcHandlers() {
     });
 
     if (!result.canceled && result.filePath) {
-      const accounts = await accountStorage.getAccounts();
-      await accountStorage.exportAccounts(accounts, result.filePath, format);
+      await accountStorage.exportAllAccounts(result.filePath, format);
       return { success: true };
     }
 
@@ -312,26 +435,42 @@ export function setupIpcHandlers() {
     if (!result.canceled && result.filePaths.length > 0) {
       const filePath = result.filePaths[0];
       const format = path.extname(filePath).toLowerCase().substring(1) as 'json' | 'csv';
-      const importData = await accountStorage.parseImportFile(filePath, format);
-      return { success: true, importData };
+      let lastProgress = 0;
+      try {
+        const importData = await accountStorage.parseImportFile(filePath, format, (progress) => {
+          // Throttle to a few updates per second on large files
+          const now = Date.now();
+          if (now - lastProgress >= 100) {
+            lastProgress = now;
+            mainWindow?.webContents.send('import-progress', { ...progress, done: false });
+          }
+        });
+        return { success: true, importData };
+      } finally {
+        mainWindow?.webContents.send('import-progress', { done: true });
+      }
     }
 
     return { success: false, importData: null };
   });
 
-  ipcMain.handle('import-selected-accounts', async (_, selectedAccounts: Partial<Account>[]) => {
-    const result = await accountStorage.importSelectedAccounts(selectedAccounts);
-
-    return {
-      success: true,
-      count: result.savedAccounts.length,
-      errors: result.errors,
-    };
-  });
+  ipcMain.handle(
+    'import-selected-accounts',
+    async (_, selectedAccounts: Partial<Account>[], mode?: AccountBatchMode) => {
+      const result = await accountStorage.importSelectedAccounts(selectedAccounts, mode);
+
+      return {
+        success: true,
+        count: result.savedAccounts.length,
+        updated: result.updatedAccounts.length,
+        errors: result.errors,
+      };
+    }
+  );
 
   ipcMain.handle('open-webview', async (_, accountId: string) => {
-    const accounts = await accountStorage.getAccounts();
-    const account = accounts.find((a) => a.id === accountId);
+    await accountStorage.whenReady();
+    const account = accountStorage.getAccountById(accountId);
     if (!account) {
       return { success: false, error: 'Account not found' };
     }
@@ -354,27 +493,41 @@ export function setupIpcHandlers() {
     return { success: true };
   });
 
+  ipcMain.handle('get-autofill-stats', async () => {
+    return webViewManager.getAutofillStats();
+  });
+
   ipcMain.handle('get-running-processes', async () => {
     return gameProcessManager.getRunningProcesses();
   });
 
-  gameProcessManager.on('status-update', (accountId: string, running: boolean) => {
-    const processInfo = running
-      ? gameProcessManager.getRunningProcesses().find((p) => p.accountId === accountId)
-      : null;
-    console.log(
-      `📤 Sending status update: ${accountId}, running: ${running}, PID: ${processInfo?.pid || 'none'}`
-    );
-    mainWindow?.webContents.send('process-status-update', { accountId, running, processInfo });
+  launchScheduler.on('progress', (progress: JobProgress) => {
+    operationJobs.report(progress.jobId, progress);
+  });
+
+  resourceMonitor.on('update', (resources: Record<string, ClientResources>) => {
+    mainWindow?.webContents.send('process-resources', resources);
+  });
+
+  // Account and process changes reach the renderer as coalesced deltas
+  stateDeltaPublisher = new StateDeltaPublisher(accountStorage, gameProcessManager, (delta) => {
+    metrics.increment('ipc.stateDelta');
+    mainWindow?.webContents.send('state-delta', delta);
   });
 
   // Add cleanup listener to properly destroy services and prevent memory leaks
   ipcMain.on('cleanup-services', () => {
     console.log('Cleaning up services...');
     try {
+      stateDeltaPublisher.destroy();
+      launchScheduler.destroy();
+      operationJobs.destroy();
+      resourceMonitor.destroy();
       gameProcessManager.destroy();
+      processSnapshot.destroy();
       accountStorage.destroy();
       webViewManager.destroy();
+      void workerPool.destroy();
     } catch (error) {
       console.error('Error during service cleanup:', error);
     }
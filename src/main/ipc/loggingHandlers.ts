@@ -1,5 +1,5 @@
-import { ipcMain, clipboard } from 'electron';
-import { logger, LogLevel, LogFilter } from '../services/loggingService';
+import { ipcMain, clipboard, dialog } from 'electron';
+import { logger, LogLevel, LogFilter, LogQuery } from '../services/loggingService';
 import { mainWindow } from '../main';
 
 export function setupLoggingHandlers() {
@@ -10,6 +10,11 @@ export function setupLoggingHandlers() {
     return logs;
   });
 
+  // Filtered, limited log view for the log panel
+  ipcMain.handle('query-logs', async (_, query?: LogQuery) => {
+    return logger.queryLogs(query);
+  });
+
   // Get recent errors
   ipcMain.handle('get-recent-errors', async (_, count?: number) => {
     return logger.getRecentErrors(count);
@@ -22,8 +27,20 @@ export function setupLoggingHandlers() {
   });
 
   // Export logs
-  ipcMain.handle('export-logs', async (_, outputPath: string, filter?: LogFilter) => {
+  ipcMain.handle('export-logs', async (_, outputPath?: string, filter?: LogFilter) => {
     try {
+      if (!outputPath) {
+        const result = await dialog.showSaveDialog({
+          title: 'Export Logs',
+          defaultPath: 'logs.txt',
+          filters: [{ name: 'Log Files', extensions: ['txt', 'log'] }],
+        });
+        if (result.canceled || !result.filePath) {
+          return { success: false, canceled: true };
+        }
+        outputPath = result.filePath;
+      }
+
       await logger.exportLogs(outputPath, filter);
       return { success: true };
     } catch (error: any) {
@@ -33,8 +50,7 @@ export function setupLoggingHandlers() {
 
   // Copy log entry to clipboard
   ipcMain.handle('copy-log-entry', async (_, logId: string) => {
-    const logs = logger.getLogs();
-    const entry = logs.find((log) => log.id === logId);
+    const entry = logger.getLogById(logId);
 
     if (entry) {
       const formatted = logger.formatForClipboard(entry);
@@ -51,6 +67,16 @@ export function setupLoggingHandlers() {
     return { success: true };
   });
 
+  // Per-subsystem level, e.g. ('LAUNCH', LogLevel.DEBUG); takes effect immediately
+  ipcMain.handle('set-log-context-level', async (_, context: string, level: LogLevel | null) => {
+    logger.setContextLevel(context, level);
+    return { success: true };
+  });
+
+  ipcMain.handle('get-log-levels', async () => {
+    return logger.getLogLevels();
+  });
+
   // Get current operation
   ipcMain.handle('get-current-operation', async () => {
     return logger.getCurrentOperation();
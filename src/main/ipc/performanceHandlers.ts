@@ -0,0 +1,45 @@
+import { ipcMain, dialog } from 'electron';
+import { RendererTiming } from '../../shared/types';
+import { metrics } from '../services/performanceMetrics';
+import { startupProfile } from '../services/startupProfile';
+
+export function setupPerformanceHandlers() {
+  // p50/p95 per instrumented operation, counters and startup stages for the performance tab
+  ipcMain.handle('get-performance-summary', async () => {
+    return metrics.getSummary(startupProfile.getMarks());
+  });
+
+  ipcMain.handle('reset-performance-metrics', async () => {
+    metrics.reset();
+    return { success: true };
+  });
+
+  // Saves the span buffer in Chrome trace format (chrome://tracing, Perfetto)
+  ipcMain.handle('export-performance-trace', async (_, outputPath?: string) => {
+    try {
+      if (!outputPath) {
+        const result = await dialog.showSaveDialog({
+          title: 'Export Performance Trace',
+          defaultPath: 'pw-manager-trace.json',
+          filters: [{ name: 'Trace Files', extensions: ['json'] }],
+        });
+        if (result.canceled || !result.filePath) {
+          return { success: false, canceled: true };
+        }
+        outputPath = result.filePath;
+      }
+
+      await metrics.exportTrace(outputPath);
+      return { success: true };
+    } catch (error: any) {
+      return { success: false, error: error.message };
+    }
+  });
+
+  // IPC round trips and render times measured in the renderer, sent in batches by preload
+  ipcMain.on('performance-samples', (_, timings: RendererTiming[]) => {
+    if (Array.isArray(timings)) {
+      metrics.recordRendererTimings(timings);
+    }
+  });
+}
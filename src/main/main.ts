@@ -1,11 +1,11 @@
 import { app, BrowserWindow, ipcMain, dialog, Menu } from 'electron';
 import * as path from 'path';
-import { setupIpcHandlers } from './ipc/handlers';
+import { runDeferredStartup, setupIpcHandlers } from './ipc/handlers';
 import { createApplicationMenu } from './menu';
 import { SettingsManager } from './services/settingsManager';
+import { startupProfile } from './services/startupProfile';
 
 let mainWindow: BrowserWindow | null = null;
-let settingsManager: SettingsManager;
 
 app.commandLine.appendSwitch('lang', 'en-US');
 app.commandLine.appendSwitch('--enable-features', 'DefaultEncodingIsUTF8');
@@ -14,7 +14,7 @@ if (process.platform === 'win32') {
 }
 
 function createWindow() {
-  settingsManager = new SettingsManager();
+  const settingsManager = SettingsManager.getInstance();
   const savedBounds = settingsManager.getWindowBounds();
 
   mainWindow = new BrowserWindow({
@@ -38,14 +38,21 @@ function createWindow() {
 
   mainWindow.once('ready-to-show', () => {
     mainWindow?.show();
+    startupProfile.mark('window-shown');
+
+    // Leave the first second to the renderer's initial requests
+    setTimeout(runDeferredStartup, 1000);
   });
 
-  mainWindow.on('close', () => {
-    if (mainWindow) {
-      const bounds = mainWindow.getBounds();
-      settingsManager.saveWindowBounds(bounds);
+  // Bounds writes are coalesced, so they can follow every move instead of only the close
+  const saveBounds = () => {
+    if (mainWindow && !mainWindow.isMinimized() && !mainWindow.isMaximized()) {
+      settingsManager.saveWindowBounds(mainWindow.getBounds());
     }
-  });
+  };
+  mainWindow.on('resized', saveBounds);
+  mainWindow.on('moved', saveBounds);
+  mainWindow.on('close', saveBounds);
 
   mainWindow.on('closed', () => {
     mainWindow = null;
@@ -55,7 +62,9 @@ function createWindow() {
 }
 
 app.whenReady().then(() => {
+  startupProfile.mark('app-ready');
   setupIpcHandlers();
+  startupProfile.mark('services-created');
   createWindow();
 
   app.on('activate', () => {
@@ -84,4 +93,9 @@ app.on('before-quit', async () => {
   }
 });
 
+// After every window has closed, so the final window bounds are part of the last write
+app.on('will-quit', () => {
+  SettingsManager.getInstance().destroy();
+});
+
 export { mainWindow };
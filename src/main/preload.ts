@@ -1,32 +1,50 @@
 import { contextBridge, ipcRenderer, IpcRendererEvent } from 'electron';
+import type { RendererTiming } from '../shared/types';
 
 const validChannels = [
   'get-accounts',
+  'get-account-changes',
+  'get-roster-snapshot',
   'save-account',
   'delete-account',
   'delete-batch-file',
   'launch-game',
+  'cancel-launch',
+  'job-progress',
+  'await-job',
+  'process-resources',
   'close-game',
   'get-settings',
   'save-settings',
   'select-game-folder',
   'scan-batch-files',
+  'scan-progress',
+  'cancel-scan',
   'export-accounts',
   'export-selected-accounts',
   'import-accounts',
   'import-selected-accounts',
-  'process-status-update',
+  'import-progress',
+  'state-delta',
   'get-running-processes',
   'open-webview',
   'close-webview',
   'close-all-webviews',
+  'get-autofill-stats',
   // Logging channels
   'get-logs',
+  'query-logs',
   'get-recent-errors',
   'clear-logs',
   'export-logs',
   'copy-log-entry',
   'set-log-level',
+  'set-log-context-level',
+  'get-log-levels',
+  // Performance channels
+  'get-performance-summary',
+  'reset-performance-metrics',
+  'export-performance-trace',
   'get-current-operation',
   'log-added',
   'error-logged',
@@ -34,20 +52,48 @@ const validChannels = [
   'logs-cleared',
 ];
 
+// Renderer-side timings go to main in one message every couple of seconds
+const pendingTimings: RendererTiming[] = [];
+let timingsTimer: ReturnType<typeof setTimeout> | null = null;
+
+function recordTiming(name: string, startedAt: number, durationMs: number): void {
+  pendingTimings.push({ name, startedAt, durationMs });
+  if (!timingsTimer) {
+    timingsTimer = setTimeout(() => {
+      timingsTimer = null;
+      ipcRenderer.send('performance-samples', pendingTimings.splice(0));
+    }, 2000);
+  }
+}
+
 const api = {
+  // Every invoke is timed as an IPC round trip (ipc.<channel>)
   invoke: (channel: string, ...args: any[]) => {
     if (validChannels.includes(channel)) {
-      return ipcRenderer.invoke(channel, ...args);
+      const started = performance.now();
+      return ipcRenderer.invoke(channel, ...args).finally(() => {
+        const durationMs = performance.now() - started;
+        recordTiming(`ipc.${channel}`, performance.timeOrigin + started, durationMs);
+      });
     }
     throw new Error(`Invalid channel: ${channel}`);
   },
 
+  // For work measured in the renderer itself, e.g. ('renderer.renderAccountTable', ms)
+  reportTiming: (name: string, durationMs: number) => {
+    recordTiming(name, performance.timeOrigin + performance.now() - durationMs, durationMs);
+  },
+
   on: (channel: string, listener: (event: IpcRendererEvent, ...args: any[]) => void) => {
     if (validChannels.includes(channel)) {
       ipcRenderer.on(channel, listener);
     }
   },
 
+  // Resolves once a launch/close job ends (or timeoutMs passes) with its final progress
+  awaitJob: (jobId: string, timeoutMs?: number) =>
+    ipcRenderer.invoke('await-job', jobId, timeoutMs),
+
   removeListener: (
     channel: string,
     listener: (event: IpcRendererEvent, ...args: any[]) => void
@@ -0,0 +1,372 @@
+import { createReadStream, createWriteStream } from 'fs';
+import * as fs from 'fs/promises';
+import { once } from 'events';
+import { Account } from '../../shared/types';
+
+export const CSV_HEADERS = ['login', 'password', 'server', 'characterName', 'description', 'owner'];
+
+export interface ImportProgress {
+  bytesRead: number;
+  totalBytes: number;
+  accounts: number;
+}
+
+// RFC 4180 parser fed in chunks: quoted fields may contain commas, doubled quotes and line
+// breaks, and a record may span any number of chunks
+export class CsvStreamParser {
+  private onRow: (row: string[]) => void;
+  private row: string[] = [];
+  private field = '';
+  private inQuotes = false;
+  private quotePending = false; // Saw a quote inside a quoted field; next char decides
+  private fieldStarted = false;
+
+  constructor(onRow: (row: string[]) => void) {
+    this.onRow = onRow;
+  }
+
+  write(chunk: string): void {
+    for (let i = 0; i < chunk.length; i++) {
+      const ch = chunk[i];
+
+      if (this.inQuotes) {
+        if (this.quotePending) {
+          this.quotePending = false;
+          if (ch === '"') {
+            this.field += '"';
+            continue;
+          }
+          this.inQuotes = false;
+          // Fall through: the quote closed the field, handle ch as unquoted
+        } else if (ch === '"') {
+          this.quotePending = true;
+          continue;
+        } else {
+          this.field += ch;
+          continue;
+        }
+      }
+
+      if (ch === ',') {
+        this.endField();
+      } else if (ch === '\n') {
+        this.endRow();
+      } else if (ch === '\r') {
+        // CRLF and bare CR both end the row; the LF of a CRLF then sees an empty row
+        this.endRow();
+      } else if (ch === '"' && !this.fieldStarted) {
+        this.inQuotes = true;
+        this.fieldStarted = true;
+      } else {
+        this.field += ch;
+        this.fieldStarted = true;
+      }
+    }
+  }
+
+  end(): void {
+    if (this.quotePending) {
+      this.quotePending = false;
+      this.inQuotes = false;
+    }
+    this.endRow();
+  }
+
+  private endField(): void {
+    this.row.push(this.field);
+    this.field = '';
+    this.fieldStarted = false;
+  }
+
+  private endRow(): void {
+    if (this.row.length === 0 && !this.fieldStarted && this.field === '') {
+      return; // Blank line
+    }
+    this.endField();
+    const row = this.row;
+    this.row = [];
+    this.onRow(row);
+  }
+}
+
+// Incremental parser for the two JSON export layouts: a bare array of accounts, or the old
+// { metadata, accounts: [...] } wrapper. Only the element being read is held in memory; any
+// other top-level object is treated as a single account once it closes.
+export class JsonAccountStreamParser {
+  private onAccount: (account: any) => void;
+  private buffer = '';
+  private offset = 0; // Absolute position of buffer[0]
+  private position = 0; // Absolute position of the next char to scan
+  private depth = 0;
+  private inString = false;
+  private escaped = false;
+  private stringStart = -1;
+  private lastKey: string | null = null;
+  private topLevel: 'unknown' | 'array' | 'object' = 'unknown';
+  private elementDepth = -1; // Depth of the array whose elements are accounts
+  private elementStart = -1;
+  private isWrapper = false;
+
+  constructor(onAccount: (account: any) => void) {
+    this.onAccount = onAccount;
+  }
+
+  write(chunk: string): void {
+    this.buffer += chunk;
+    const end = this.offset + this.buffer.length;
+
+    while (this.position < end) {
+      const ch = this.buffer[this.position - this.offset];
+      this.scan(ch);
+      this.position++;
+    }
+
+    this.trimBuffer();
+  }
+
+  end(): void {
+    if (this.depth !== 0 || this.inString) {
+      throw new Error('Unexpected end of JSON input');
+    }
+  }
+
+  private scan(ch: string): void {
+    if (this.inString) {
+      if (this.escaped) {
+        this.escaped = false;
+      } else if (ch === '\\') {
+        this.escaped = true;
+      } else if (ch === '"') {
+        this.inString = false;
+        if (this.depth === 1 && this.topLevel === 'object') {
+          this.lastKey = this.slice(this.stringStart + 1, this.position);
+        }
+      }
+      return;
+    }
+
+    switch (ch) {
+      case '"':
+        this.inString = true;
+        this.stringStart = this.position;
+        this.beginElement();
+        break;
+      case '{':
+      case '[':
+        if (this.depth === 0) {
+          this.topLevel = ch === '[' ? 'array' : 'object';
+          if (ch === '[') {
+            this.elementDepth = 1;
+          } else {
+            this.elementStart = this.position; // Held until we know it is not a wrapper
+          }
+        } else if (
+          ch === '[' &&
+          this.depth === 1 &&
+          this.topLevel === 'object' &&
+          this.lastKey === 'accounts'
+        ) {
+          // Old wrapper format: stop holding the wrapper and stream its accounts array
+          this.isWrapper = true;
+          this.elementDepth = 2;
+          this.elementStart = -1;
+          this.depth++;
+          return;
+        } else {
+          this.beginElement();
+        }
+        this.depth++;
+        break;
+      case '}':
+      case ']':
+        this.depth--;
+        if (this.depth === this.elementDepth && this.elementStart !== -1) {
+          this.emitElement(this.position + 1);
+        } else if (this.depth === this.elementDepth - 1) {
+          this.elementDepth = -1; // Accounts array closed
+          this.elementStart = -1;
+        } else if (this.depth === 0 && this.topLevel === 'object' && !this.isWrapper) {
+          this.emitElement(this.position + 1);
+        }
+        break;
+      case ',':
+        if (this.depth === this.elementDepth && this.elementStart !== -1) {
+          this.emitElement(this.position);
+        }
+        break;
+      default:
+        if (ch.trim() && ch !== ':') {
+          this.beginElement();
+        }
+    }
+  }
+
+  private beginElement(): void {
+    if (this.depth === this.elementDepth && this.elementStart === -1) {
+      this.elementStart = this.position;
+    }
+  }
+
+  private emitElement(endPosition: number): void {
+    const text = this.slice(this.elementStart, endPosition);
+    this.elementStart = -1;
+    const value = JSON.parse(text);
+    if (value && typeof value === 'object' && !Array.isArray(value)) {
+      this.onAccount(value);
+    }
+  }
+
+  private slice(start: number, end: number): string {
+    return this.buffer.substring(start - this.offset, end - this.offset);
+  }
+
+  // Drops everything before the element (or key string) still being read
+  private trimBuffer(): void {
+    let keep = this.position;
+    if (this.elementStart !== -1) {
+      keep = Math.min(keep, this.elementStart);
+    }
+    if (this.inString) {
+      keep = Math.min(keep, this.stringStart);
+    }
+    if (keep > this.offset) {
+      this.buffer = this.buffer.substring(keep - this.offset);
+      this.offset = keep;
+    }
+  }
+}
+
+// Maps old-format field names and drops empty optional fields
+export function normalizeImportedAccount(account: any): Partial<Account> {
+  const normalized: any = { ...account };
+
+  // Convert character_name to characterName
+  if (normalized.character_name !== undefined) {
+    normalized.characterName = normalized.character_name;
+    delete normalized.character_name;
+  }
+
+  if (normalized.characterName && normalized.characterName.includes('?')) {
+    console.error(`⚠️ Import: Character name already corrupted in source file!`);
+  }
+
+  // Ensure empty strings are converted to undefined for optional fields
+  if (normalized.characterName === '') normalized.characterName = undefined;
+  if (normalized.description === '') normalized.description = undefined;
+  if (normalized.owner === '') normalized.owner = undefined;
+
+  return normalized;
+}
+
+// Streams a CSV or JSON export file, calling onAccount for each record as it is parsed
+export async function readAccountFile(
+  filePath: string,
+  format: 'json' | 'csv',
+  onAccount: (account: any) => void,
+  onProgress?: (progress: ImportProgress) => void,
+  signal?: AbortSignal
+): Promise<void> {
+  const { size: totalBytes } = await fs.stat(filePath);
+  let accounts = 0;
+  const emit = (account: any) => {
+    accounts++;
+    onAccount(account);
+  };
+
+  let headers: string[] | null = null;
+  const parser =
+    format === 'json'
+      ? new JsonAccountStreamParser(emit)
+      : new CsvStreamParser((row) => {
+          if (!headers) {
+            headers = row.map((h) => h.trim());
+            return;
+          }
+          const account: any = {};
+          headers.forEach((header, index) => {
+            const value = row[index]?.trim() ?? '';
+            if (value) {
+              account[header] = value;
+            }
+          });
+          emit(account);
+        });
+
+  // Ensure UTF-8 decoding; a BOM from spreadsheet exports is dropped
+  const stream = createReadStream(filePath, { encoding: 'utf-8', highWaterMark: 64 * 1024 });
+  let first = true;
+  for await (let chunk of stream as AsyncIterable<string>) {
+    if (first && chunk.charCodeAt(0) === 0xfeff) {
+      chunk = chunk.substring(1);
+    }
+    first = false;
+    signal?.throwIfAborted();
+    parser.write(chunk);
+    onProgress?.({ bytesRead: stream.bytesRead, totalBytes, accounts });
+  }
+  parser.end();
+}
+
+// Position of one slice of an export written in several calls
+export interface AccountFileChunk {
+  index: number; // Accounts written by earlier chunks; 0 starts a new file
+  last: boolean; // Closes the JSON array after this chunk
+}
+
+// Writes an export record by record, waiting for the file stream to drain whenever its
+// buffer fills, so memory stays flat regardless of roster size. Chunks written in order
+// produce the same bytes as one call with every account.
+export async function writeAccountFile(
+  filePath: string,
+  accounts: Iterable<Account>,
+  format: 'json' | 'csv',
+  signal?: AbortSignal,
+  chunk: AccountFileChunk = { index: 0, last: true }
+): Promise<void> {
+  const flags = chunk.index === 0 ? 'w' : 'a';
+  const stream = createWriteStream(filePath, { encoding: 'utf-8', flags });
+  const failed = once(stream, 'error').then(([error]) => Promise.reject(error));
+  failed.catch(() => undefined);
+
+  const write = async (text: string) => {
+    signal?.throwIfAborted();
+    if (!stream.write(text)) {
+      await Promise.race([once(stream, 'drain'), failed]);
+    }
+  };
+
+  try {
+    if (format === 'json') {
+      // Same bytes as JSON.stringify(accounts, null, 2)
+      let count = chunk.index;
+      for (const account of accounts) {
+        const element = JSON.stringify(account, null, 2).replace(/\n/g, '\n  ');
+        await write((count === 0 ? '[\n  ' : ',\n  ') + element);
+        count++;
+      }
+      if (chunk.last) {
+        await write(count === 0 ? '[]' : '\n]');
+      }
+    } else {
+      if (chunk.index === 0) {
+        await write(CSV_HEADERS.join(','));
+      }
+      for (const account of accounts) {
+        await write('\n' + formatCsvRow(account));
+      }
+    }
+
+    stream.end();
+    await Promise.race([once(stream, 'finish'), failed]);
+  } catch (error) {
+    stream.destroy();
+    throw error;
+  }
+}
+
+function formatCsvRow(account: Account): string {
+  return CSV_HEADERS.map((h) => {
+    const value = account[h as keyof Account];
+    return value !== undefined ? `"${String(value).replace(/"/g, '""')}"` : '';
+  }).join(',');
+}
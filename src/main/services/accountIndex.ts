@@ -0,0 +1,133 @@
+import { Account } from '../../shared/types';
+
+// In-memory account table with hash indexes. The primary map keeps insertion order so
+// values() matches the order accounts were loaded or created in, like the old array did.
+export class AccountIndex {
+  private byId: Map<string, Account> = new Map();
+  private byLogin: Map<string, string> = new Map(); // login -> id
+  private byServer: Map<string, Set<string>> = new Map(); // server -> ids
+  private byOwner: Map<string, Set<string>> = new Map(); // owner -> ids, only accounts with an owner
+
+  constructor(accounts: Account[] = []) {
+    this.load(accounts);
+  }
+
+  load(accounts: Account[]): void {
+    this.clear();
+    for (const account of accounts) {
+      this.set(account);
+    }
+  }
+
+  clear(): void {
+    this.byId.clear();
+    this.byLogin.clear();
+    this.byServer.clear();
+    this.byOwner.clear();
+  }
+
+  get size(): number {
+    return this.byId.size;
+  }
+
+  values(): Account[] {
+    return Array.from(this.byId.values());
+  }
+
+  getById(id: string): Account | undefined {
+    return this.byId.get(id);
+  }
+
+  getByLogin(login: string): Account | undefined {
+    const id = this.byLogin.get(login);
+    return id !== undefined ? this.byId.get(id) : undefined;
+  }
+
+  getByServer(server: string): Account[] {
+    return this.resolveIds(this.byServer.get(server));
+  }
+
+  getByOwner(owner: string): Account[] {
+    return this.resolveIds(this.byOwner.get(owner));
+  }
+
+  has(id: string): boolean {
+    return this.byId.has(id);
+  }
+
+  hasLogin(login: string): boolean {
+    return this.byLogin.has(login);
+  }
+
+  // Inserts or replaces the account with the same id, re-keying every secondary index
+  set(account: Account): void {
+    const previous = this.byId.get(account.id);
+    if (previous) {
+      this.unindex(previous);
+    }
+
+    this.byId.set(account.id, account);
+    this.byLogin.set(account.login, account.id);
+    addToBucket(this.byServer, account.server, account.id);
+    if (account.owner) {
+      addToBucket(this.byOwner, account.owner, account.id);
+    }
+  }
+
+  delete(id: string): boolean {
+    const account = this.byId.get(id);
+    if (!account) {
+      return false;
+    }
+
+    this.unindex(account);
+    this.byId.delete(id);
+    return true;
+  }
+
+  private unindex(account: Account): void {
+    if (this.byLogin.get(account.login) === account.id) {
+      this.byLogin.delete(account.login);
+    }
+    removeFromBucket(this.byServer, account.server, account.id);
+    if (account.owner) {
+      removeFromBucket(this.byOwner, account.owner, account.id);
+    }
+  }
+
+  private resolveIds(ids: Set<string> | undefined): Account[] {
+    if (!ids) {
+      return [];
+    }
+
+    const accounts: Account[] = [];
+    for (const id of ids) {
+      const account = this.byId.get(id);
+      if (account) {
+        accounts.push(account);
+      }
+    }
+    return accounts;
+  }
+}
+
+function addToBucket(index: Map<string, Set<string>>, key: string, id: string): void {
+  let bucket = index.get(key);
+  if (!bucket) {
+    bucket = new Set();
+    index.set(key, bucket);
+  }
+  bucket.add(id);
+}
+
+function removeFromBucket(index: Map<string, Set<string>>, key: string, id: string): void {
+  const bucket = index.get(key);
+  if (!bucket) {
+    return;
+  }
+
+  bucket.delete(id);
+  if (bucket.size === 0) {
+    index.delete(key);
+  }
+}
@@ -0,0 +1,206 @@
+import * as path from 'path';
+import * as fs from 'fs/promises';
+import { appendFileSync } from 'fs';
+import { Account } from '../../shared/types';
+
+export type JournalRecord = { op: 'put'; account: Account } | { op: 'delete'; id: string };
+
+export interface AccountPersistenceOptions {
+  flushDelay?: number; // Debounce before pending records are appended
+  compactThreshold?: number; // Journal records that trigger a snapshot rewrite
+}
+
+// accounts.json stays the snapshot (same pretty-printed array as before); every mutation is
+// appended to accounts.journal as one JSON line. Records carry the full account, so replaying
+// them is idempotent and a crash between snapshot rename and journal truncation is harmless.
+export class AccountPersistence {
+  private snapshotPath: string;
+  private journalPath: string;
+  private getState: () => Account[];
+  private pending: JournalRecord[] = [];
+  private journalRecords = 0;
+  private tornJournal = false;
+  private flushTimeout: NodeJS.Timeout | null = null;
+  private writeChain: Promise<void> = Promise.resolve();
+  private readonly flushDelay: number;
+  private readonly compactThreshold: number;
+
+  constructor(
+    snapshotPath: string,
+    getState: () => Account[],
+    options: AccountPersistenceOptions = {}
+  ) {
+    this.snapshotPath = snapshotPath;
+    this.journalPath = snapshotPath.replace(/\.json$/i, '') + '.journal';
+    this.getState = getState;
+    this.flushDelay = options.flushDelay ?? 500;
+    this.compactThreshold = options.compactThreshold ?? 200;
+  }
+
+  // Reads the snapshot and replays the journal on top of it
+  async load(): Promise<Account[]> {
+    const accounts = new Map<string, Account>();
+
+    try {
+      const data = await fs.readFile(this.snapshotPath, 'utf-8');
+      for (const account of JSON.parse(data) as Account[]) {
+        accounts.set(account.id, account);
+      }
+    } catch (error: any) {
+      if (error.code !== 'ENOENT') {
+        console.error('📄 Could not read accounts snapshot:', error);
+      }
+    }
+
+    let journal = '';
+    try {
+      journal = await fs.readFile(this.journalPath, 'utf-8');
+    } catch {
+      // No journal - snapshot is complete
+    }
+
+    this.journalRecords = 0;
+    this.tornJournal = false;
+    for (const line of journal.split('\n')) {
+      if (!line.trim()) {
+        continue;
+      }
+
+      let record: JournalRecord;
+      try {
+        record = JSON.parse(line);
+      } catch {
+        // A torn final line from a crash mid-append; everything before it is intact
+        console.warn('📄 Ignoring truncated journal record');
+        this.tornJournal = true;
+        break;
+      }
+
+      applyRecord(accounts, record);
+      this.journalRecords++;
+    }
+
+    if (this.journalRecords > 0) {
+      console.log(`📄 Replayed ${this.journalRecords} journal records`);
+    }
+
+    return Array.from(accounts.values());
+  }
+
+  // Rewrites the snapshot after load if the journal is long or ends in a torn record, since
+  // appending after a torn line would hide every later record from the next replay
+  async compactIfNeeded(): Promise<void> {
+    if (this.tornJournal || this.journalRecords >= this.compactThreshold) {
+      await this.compact();
+      this.tornJournal = false;
+    }
+  }
+
+  recordPut(account: Account): void {
+    this.enqueue({ op: 'put', account });
+  }
+
+  recordDelete(id: string): void {
+    this.enqueue({ op: 'delete', id });
+  }
+
+  private enqueue(record: JournalRecord): void {
+    this.pending.push(record);
+
+    if (this.flushTimeout) {
+      clearTimeout(this.flushTimeout);
+    }
+    this.flushTimeout = setTimeout(() => {
+      this.flushTimeout = null;
+      this.flush().catch((error) => console.error('💾 Journal flush failed:', error));
+    }, this.flushDelay);
+  }
+
+  // Appends pending records, then compacts in the background once the journal is long enough
+  flush(): Promise<void> {
+    return this.enqueueWrite(async () => {
+      if (this.pending.length === 0) {
+        return;
+      }
+
+      const records = this.pending;
+      this.pending = [];
+      await this.ensureDirectory();
+      await fs.appendFile(this.journalPath, serializeRecords(records), 'utf-8');
+      this.journalRecords += records.length;
+
+      if (this.journalRecords >= this.compactThreshold) {
+        this.compact().catch((error) => console.error('💾 Journal compaction failed:', error));
+      }
+    });
+  }
+
+  // Writes the current state as a new snapshot (temp file + rename) and empties the journal
+  compact(): Promise<void> {
+    return this.enqueueWrite(async () => {
+      // Everything still pending is already part of the in-memory state being written
+      this.pending = [];
+      if (this.flushTimeout) {
+        clearTimeout(this.flushTimeout);
+        this.flushTimeout = null;
+      }
+
+      await this.ensureDirectory();
+      const tempPath = `${this.snapshotPath}.tmp`;
+      const handle = await fs.open(tempPath, 'w');
+      try {
+        await handle.writeFile(JSON.stringify(this.getState(), null, 2), 'utf-8');
+        await handle.sync();
+      } finally {
+        await handle.close();
+      }
+
+      await fs.rename(tempPath, this.snapshotPath);
+      await fs.writeFile(this.journalPath, '', 'utf-8');
+      console.log(`💾 Compacted ${this.journalRecords} journal records into snapshot`);
+      this.journalRecords = 0;
+    });
+  }
+
+  // Synchronous last-chance append for shutdown, when async writes may never complete
+  flushSync(): void {
+    if (this.flushTimeout) {
+      clearTimeout(this.flushTimeout);
+      this.flushTimeout = null;
+    }
+
+    if (this.pending.length === 0) {
+      return;
+    }
+
+    try {
+      appendFileSync(this.journalPath, serializeRecords(this.pending), 'utf-8');
+      this.journalRecords += this.pending.length;
+    } catch (error) {
+      console.error('💾 Could not flush journal on shutdown:', error);
+    }
+    this.pending = [];
+  }
+
+  private enqueueWrite(task: () => Promise<void>): Promise<void> {
+    const run = this.writeChain.then(task);
+    this.writeChain = run.catch(() => undefined);
+    return run;
+  }
+
+  private async ensureDirectory(): Promise<void> {
+    await fs.mkdir(path.dirname(this.snapshotPath), { recursive: true });
+  }
+}
+
+function applyRecord(accounts: Map<string, Account>, record: JournalRecord): void {
+  if (record.op === 'put' && record.account?.id) {
+    accounts.set(record.account.id, record.account);
+  } else if (record.op === 'delete') {
+    accounts.delete(record.id);
+  }
+}
+
+function serializeRecords(records: JournalRecord[]): string {
+  return records.map((record) => JSON.stringify(record)).join('\n') + '\n';
+}
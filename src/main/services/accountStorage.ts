@@ -1,123 +1,269 @@
 import { app } from 'electron';
-import * as path from 'path';
+import { EventEmitter } from 'events';
 import * as fs from 'fs/promises';
+import * as path from 'path';
 import { Account } from '../../shared/types';
 import { generateAccountId, validateAccount } from '../../shared/utils/validation';
+import { AccountIndex } from './accountIndex';
+import { AccountPersistence } from './accountPersistence';
+import { FileExistenceCache } from './fileExistenceCache';
+import { ImportProgress } from './accountFileStream';
+import { logger } from './loggingService';
+import { workerPool } from './workerPool';
+
+export interface AccountChanges {
+  version: number;
+  full: boolean; // accounts is the complete list rather than a delta
+  accounts: Account[];
+  removed: string[];
+}
+
+export type AccountBatchMode = 'insert' | 'upsert';
 
-export class AccountStorage {
+export interface AccountBatchResult {
+  savedAccounts: Account[]; // Newly created
+  updatedAccounts: Account[]; // Existing logins merged in upsert mode
+  errors: { login: string; error: string }[];
+}
+
+// Emits 'change' (version) whenever the change version moves
+export class AccountStorage extends EventEmitter {
   private accountsPath: string;
-  private accounts: Account[] = [];
-  private saveTimeout: NodeJS.Timeout | null = null;
+  private rosterPath: string;
+  private rosterTimer: NodeJS.Timeout | null = null;
+  private ready: Promise<void>;
+  private loaded = false;
+  private accounts: AccountIndex = new AccountIndex();
+  private persistence: AccountPersistence;
+  private batchFiles: FileExistenceCache = new FileExistenceCache();
+  private version = 0;
+  private changeLogFloor = 0;
+  private changedAt: Map<string, number> = new Map();
+  private removedAt: Map<string, number> = new Map();
+  private readonly MAX_TOMBSTONES = 1000;
+  private readonly EXPORT_CHUNK = 1000; // Accounts sent to the export worker per message
 
   constructor() {
+    super();
     const userDataPath = app.getPath('userData');
     this.accountsPath = path.join(userDataPath, 'accounts.json');
-    this.loadAccounts();
+    this.persistence = new AccountPersistence(this.accountsPath, () => this.accounts.values());
+    this.rosterPath = path.join(userDataPath, 'roster-cache.json');
+    this.batchFiles.on('change', this.handleBatchFileChange);
+    this.on('change', this.scheduleRosterSnapshot);
+    this.ready = this.loadAccounts().then(() => {
+      this.loaded = true;
+    });
+  }
+
+  // Resolves once the accounts file has been read; calls made before then wait for it rather
+  // than seeing an empty roster
+  whenReady(): Promise<void> {
+    return this.ready;
+  }
+
+  // The roster as last written, for painting the table while the accounts file is still
+  // loading. Passwords are never cached; null once the real data is available.
+  async getRosterSnapshot(): Promise<Account[] | null> {
+    if (this.loaded) {
+      return null;
+    }
+
+    try {
+      return JSON.parse(await fs.readFile(this.rosterPath, 'utf-8'));
+    } catch {
+      return null;
+    }
+  }
+
+  private scheduleRosterSnapshot = (): void => {
+    if (this.rosterTimer) {
+      return;
+    }
+    this.rosterTimer = setTimeout(() => {
+      this.rosterTimer = null;
+      this.writeRosterSnapshot().catch((error) =>
+        console.warn('📄 Could not write roster cache:', error)
+      );
+    }, 2000);
+    this.rosterTimer.unref();
+  };
+
+  private async writeRosterSnapshot(): Promise<void> {
+    const roster = this.accounts.values().map((account) => {
+      const { password, ...rest } = this.toRuntimeAccount(account);
+      return rest;
+    });
+    const tempPath = `${this.rosterPath}.tmp`;
+    await fs.writeFile(tempPath, JSON.stringify(roster), 'utf-8');
+    await fs.rename(tempPath, this.rosterPath);
+  }
+
+  // Everything before this point is only available as a full list
+  private resetChangeLog(): void {
+    this.version++;
+    this.changeLogFloor = this.version;
+    this.changedAt.clear();
+    this.removedAt.clear();
+    this.emit('change', this.version);
+  }
+
+  getChangeVersion(): number {
+    return this.version;
   }
 
   private async loadAccounts(): Promise<void> {
     try {
-      // Explicitly use UTF-8 encoding
-      const data = await fs.readFile(this.accountsPath, 'utf-8');
-
-      // Debug the raw JSON data
-      console.log('📄 Loading accounts from:', this.accountsPath);
-      console.log('📄 Raw JSON preview (first 200 chars):', data.substring(0, 200));
-
-      this.accounts = JSON.parse(data);
-
-      // Debug loaded accounts for Cyrillic corruption
-      console.log(`📄 Loaded ${this.accounts.length} accounts`);
-      this.accounts.forEach((account, index) => {
-        if (account.characterName) {
-          const hasQuestionMarks = account.characterName.includes('?');
-          if (hasQuestionMarks) {
-            console.error(
-              `⚠️ Account ${account.login} has corrupted character name in JSON file: "${account.characterName}"`
-            );
-          } else {
-            console.log(
-              `✅ Account ${account.login} character name loaded correctly: "${account.characterName}"`
-            );
-          }
+      logger.debug(() => `Loading accounts from ${this.accountsPath}`, null, 'STORAGE');
+      this.accounts.load(await this.persistence.load());
+      this.resetChangeLog();
+
+      // Cyrillic corruption check: only names that already contain '?' are reported
+      logger.info(`Loaded ${this.accounts.size} accounts`, null, 'STORAGE');
+      for (const account of this.accounts.values()) {
+        if (account.characterName?.includes('?')) {
+          logger.warn(
+            `Account ${account.login} has a corrupted character name in the accounts file`,
+            { characterName: account.characterName },
+            'STORAGE'
+          );
         }
-      });
+      }
+
+      await this.persistence.compactIfNeeded();
     } catch (error) {
       console.log('📄 No existing accounts file or error reading it:', error);
-      this.accounts = [];
+      this.accounts.clear();
     }
   }
 
-  private async saveAccountsDebounced(): Promise<void> {
-    if (this.saveTimeout) {
-      clearTimeout(this.saveTimeout);
-    }
+  async getAccounts(): Promise<Account[]> {
+    await this.ready;
+    logger.debug(() => `getAccounts returning ${this.accounts.size} accounts`, null, 'STORAGE');
 
-    this.saveTimeout = setTimeout(async () => {
-      await this.saveAccountsToDisk();
-    }, 500);
+    const accounts = this.accounts.values();
+    const existence = await this.resolveBatchFiles(accounts);
+    return accounts.map((account) => this.toRuntimeAccount(account, existence));
   }
 
-  private async saveAccountsToDisk(): Promise<void> {
-    const dir = path.dirname(this.accountsPath);
-    await fs.mkdir(dir, { recursive: true });
+  // Accounts added, updated or removed after `since`. Version 0, or a version older than the
+  // retained change log, gets the full list.
+  async getAccountChanges(since: number): Promise<AccountChanges> {
+    await this.ready;
+    if (since <= 0 || since < this.changeLogFloor || since > this.version) {
+      return { version: this.version, full: true, accounts: await this.getAccounts(), removed: [] };
+    }
 
-    // Debug before saving
-    console.log('💾 Saving accounts to disk...');
-    this.accounts.forEach((account) => {
-      if (account.characterName) {
-        console.log(`💾 Saving ${account.login} with character: "${account.characterName}"`);
+    const changed: Account[] = [];
+    for (const [id, changedAt] of this.changedAt.entries()) {
+      const account = changedAt > since ? this.accounts.getById(id) : undefined;
+      if (account) {
+        changed.push(account);
       }
-    });
+    }
 
-    // IMPORTANT: Explicitly specify UTF-8 encoding when writing
-    const jsonContent = JSON.stringify(this.accounts, null, 2);
-    await fs.writeFile(this.accountsPath, jsonContent, 'utf-8');
-    console.log('💾 Accounts saved successfully');
+    const removed: string[] = [];
+    for (const [id, removedAt] of this.removedAt.entries()) {
+      if (removedAt > since) {
+        removed.push(id);
+      }
+    }
+
+    const existence = await this.resolveBatchFiles(changed);
+    return {
+      version: this.version,
+      full: false,
+      accounts: changed.map((account) => this.toRuntimeAccount(account, existence)),
+      removed,
+    };
   }
 
-  async getAccounts(): Promise<Account[]> {
-    // Debug when accounts are requested
-    console.log('🔍 getAccounts called, returning', this.accounts.length, 'accounts');
-
-    // Populate runtime sourceBatchFile field if the original batch file still exists
-    const accountsWithBatchFiles = await Promise.all(
-      this.accounts.map(async (account) => {
-        const accountCopy = { ...account };
-
-        if (account.originalBatchFilePath) {
-          try {
-            await fs.access(account.originalBatchFilePath);
-            // File exists, set the runtime field
-            accountCopy.sourceBatchFile = account.originalBatchFilePath;
-          } catch {
-            // File doesn't exist, don't set the runtime field
-            accountCopy.sourceBatchFile = undefined;
-          }
-        }
+  // Existence of every launcher, including ones in folders that cannot be watched and so
+  // never enter the cache
+  private async resolveBatchFiles(accounts: Account[]): Promise<Map<string, boolean>> {
+    const paths = accounts
+      .map((account) => account.originalBatchFilePath)
+      .filter((filePath): filePath is string => !!filePath);
+    return paths.length > 0 ? await this.batchFiles.resolve(paths) : new Map();
+  }
 
-        // Debug character name when returning accounts
-        if (accountCopy.characterName && accountCopy.characterName.includes('?')) {
-          console.error(
-            `⚠️ getAccounts: ${accountCopy.login} has corrupted character name: "${accountCopy.characterName}"`
-          );
-        }
+  // Copy with the runtime sourceBatchFile field set if the original batch file still exists.
+  // Without a resolved map (the roster snapshot) only cached answers are used.
+  private toRuntimeAccount(account: Account, existence?: Map<string, boolean>): Account {
+    const accountCopy = { ...account };
+    const filePath = account.originalBatchFilePath;
+    if (filePath) {
+      const exists = existence?.get(filePath) ?? this.batchFiles.get(filePath);
+      accountCopy.sourceBatchFile = exists ? filePath : undefined;
+    }
+    return accountCopy;
+  }
 
-        return accountCopy;
-      })
-    );
+  private markChanged(id: string): void {
+    this.version++;
+    this.changedAt.set(id, this.version);
+    this.removedAt.delete(id);
+    this.emit('change', this.version);
+  }
+
+  private markRemoved(id: string): void {
+    this.version++;
+    this.changedAt.delete(id);
+    this.removedAt.set(id, this.version);
+
+    // Bound the tombstones; clients older than the floor fall back to a full reload
+    if (this.removedAt.size > this.MAX_TOMBSTONES) {
+      const [oldestId, oldestVersion] = this.removedAt.entries().next().value as [string, number];
+      this.removedAt.delete(oldestId);
+      this.changeLogFloor = oldestVersion;
+    }
+    this.emit('change', this.version);
+  }
+
+  private handleBatchFileChange = (filePath: string): void => {
+    for (const account of this.accounts.values()) {
+      if (account.originalBatchFilePath === filePath) {
+        this.markChanged(account.id);
+      }
+    }
+  };
+
+  // Direct index lookups - no batch file existence check, for callers that only need the data
+  getAccountById(id: string): Account | undefined {
+    const account = this.accounts.getById(id);
+    return account ? { ...account } : undefined;
+  }
+
+  // In the order given (the user's selection order), unknown and repeated ids skipped
+  getAccountsByIds(ids: string[]): Account[] {
+    return Array.from(new Set(ids))
+      .map((id) => this.accounts.getById(id))
+      .filter((account): account is Account => !!account)
+      .map((account) => ({ ...account }));
+  }
 
-    return accountsWithBatchFiles;
+  getAccountsByServer(server: Account['server']): Account[] {
+    return this.accounts.getByServer(server).map((account) => ({ ...account }));
+  }
+
+  getAccountsByOwner(owner: string): Account[] {
+    return this.accounts.getByOwner(owner).map((account) => ({ ...account }));
   }
 
   async saveAccount(account: Partial<Account>): Promise<Account> {
-    // Debug incoming account data
+    await this.ready;
     if (account.characterName) {
-      console.log(
-        `📝 saveAccount: Saving ${account.login} with character: "${account.characterName}"`
+      logger.debug(
+        () => `saveAccount: ${account.login} with character "${account.characterName}"`,
+        null,
+        'STORAGE'
       );
       if (account.characterName.includes('?')) {
-        console.error(`⚠️ saveAccount: Character name already corrupted!`);
+        logger.warn(
+          `saveAccount: character name of ${account.login} is already corrupted`,
+          { characterName: account.characterName },
+          'STORAGE'
+        );
       }
     }
 
@@ -129,25 +275,29 @@ export class AccountStorage {
     let savedAccount: Account;
 
     if (account.id) {
-      const index = this.accounts.findIndex((a) => a.id === account.id);
-      if (index === -1) {
+      const existing = this.accounts.getById(account.id);
+      if (!existing) {
         throw new Error('Account not found');
       }
 
-      const existingDuplicate = this.accounts.find(
-        (a) => a.login === account.login && a.id !== account.id
-      );
-      if (existingDuplicate) {
+      const existingDuplicate = this.accounts.getByLogin(account.login!);
+      if (existingDuplicate && existingDuplicate.id !== account.id) {
         throw new Error('An account with this login already exists');
       }
 
       // Exclude runtime-only fields when updating
       const { sourceBatchFile, ...accountToSave } = account;
-      savedAccount = { ...this.accounts[index], ...accountToSave } as Account;
-      this.accounts[index] = savedAccount;
+      savedAccount = { ...existing, ...accountToSave } as Account;
+      this.accounts.set(savedAccount);
+      this.persistence.recordPut(savedAccount);
+      this.markChanged(savedAccount.id);
+
+      // The batch file path may have changed - check it again on the next read
+      if (savedAccount.originalBatchFilePath) {
+        this.batchFiles.invalidate(savedAccount.originalBatchFilePath);
+      }
     } else {
-      const duplicate = this.accounts.find((a) => a.login === account.login);
-      if (duplicate) {
+      if (this.accounts.hasLogin(account.login!)) {
         throw new Error('An account with this login already exists');
       }
 
@@ -158,137 +308,87 @@ export class AccountStorage {
         id: generateAccountId(),
         isRunning: false,
       } as Account;
-      this.accounts.push(savedAccount);
+      this.accounts.set(savedAccount);
+      this.persistence.recordPut(savedAccount);
+      this.markChanged(savedAccount.id);
     }
 
-    await this.saveAccountsDebounced();
     return savedAccount;
   }
 
   async deleteAccount(id: string): Promise<void> {
-    const index = this.accounts.findIndex((a) => a.id === id);
-    if (index === -1) {
+    await this.ready;
+    if (!this.accounts.delete(id)) {
       throw new Error('Account not found');
     }
 
-    this.accounts.splice(index, 1);
-    await this.saveAccountsDebounced();
+    this.persistence.recordDelete(id);
+    this.markRemoved(id);
   }
 
+  // Serialized and written by the worker pool, which appends one fixed-size chunk per
+  // message; only that chunk is copied at a time, however large the roster
   async exportAccounts(
-    accounts: Account[],
+    accounts: Iterable<Account>,
     filePath: string,
     format: 'json' | 'csv'
   ): Promise<void> {
-    if (format === 'json') {
-      // Ensure UTF-8 encoding for export
-      await fs.writeFile(filePath, JSON.stringify(accounts, null, 2), 'utf-8');
-    } else {
-      const headers = ['login', 'password', 'server', 'characterName', 'description', 'owner'];
-      const csv = [
-        headers.join(','),
-        ...accounts.map((account) =>
-          headers
-            .map((h) => {
-              const value = account[h as keyof Account];
-              return value !== undefined ? `"${value}"` : '';
-            })
-            .join(',')
-        ),
-      ].join('\n');
-
-      // Ensure UTF-8 encoding for CSV export
-      await fs.writeFile(filePath, csv, 'utf-8');
+    let chunk: Account[] = [];
+    let index = 0;
+    for (const account of accounts) {
+      chunk.push(account);
+      if (chunk.length === this.EXPORT_CHUNK) {
+        const input = { filePath, accounts: chunk, format, chunk: { index, last: false } };
+        await workerPool.run('writeAccountFile', input);
+        index += chunk.length;
+        chunk = [];
+      }
+    }
+    const input = { filePath, accounts: chunk, format, chunk: { index, last: true } };
+    await workerPool.run('writeAccountFile', input);
+  }
+
+  async exportAllAccounts(filePath: string, format: 'json' | 'csv'): Promise<void> {
+    await this.ready;
+    const accounts = this.accounts.values();
+    const existence = await this.resolveBatchFiles(accounts);
+    await this.exportAccounts(this.runtimeAccounts(accounts, existence), filePath, format);
+  }
+
+  // Runtime copies made as the export consumes them, not all up front
+  private *runtimeAccounts(
+    accounts: Account[],
+    existence: Map<string, boolean>
+  ): Generator<Account> {
+    for (const account of accounts) {
+      yield this.toRuntimeAccount(account, existence);
     }
   }
 
   async parseImportFile(
     filePath: string,
-    format: 'json' | 'csv'
+    format: 'json' | 'csv',
+    onProgress?: (progress: ImportProgress) => void
   ): Promise<{
     accounts: Partial<Account>[];
     existing: string[];
     new: string[];
   }> {
-    // Ensure UTF-8 encoding when reading import files
-    const content = await fs.readFile(filePath, 'utf-8');
-
     console.log(`📥 Importing from ${filePath}, format: ${format}`);
-    console.log(`📥 File content preview (first 200 chars):`, content.substring(0, 200));
-
-    let importedAccounts: Partial<Account>[] = [];
-
-    if (format === 'json') {
-      const parsed = JSON.parse(content);
-
-      // Handle old format with metadata wrapper
-      if (parsed.metadata && parsed.accounts) {
-        console.log('Detected old format JSON with metadata wrapper');
-        importedAccounts = parsed.accounts;
-      } else if (Array.isArray(parsed)) {
-        console.log('Detected new format JSON (direct array)');
-        importedAccounts = parsed;
-      } else {
-        console.log('Unknown JSON format, treating as single account');
-        importedAccounts = [parsed];
-      }
-
-      // Normalize field names for old format compatibility
-      importedAccounts = importedAccounts.map((account) => {
-        const normalized: any = { ...account };
-
-        // Convert character_name to characterName
-        if (normalized.character_name !== undefined) {
-          normalized.characterName = normalized.character_name;
-          delete normalized.character_name;
-        }
-
-        // Debug imported character names
-        if (normalized.characterName) {
-          console.log(
-            `📥 Imported ${normalized.login} with character: "${normalized.characterName}"`
-          );
-          if (normalized.characterName.includes('?')) {
-            console.error(`⚠️ Import: Character name already corrupted in source file!`);
-          }
-        }
-
-        // Ensure empty strings are converted to undefined for optional fields
-        if (normalized.characterName === '') normalized.characterName = undefined;
-        if (normalized.description === '') normalized.description = undefined;
-        if (normalized.owner === '') normalized.owner = undefined;
-
-        return normalized;
-      });
-    } else {
-      const lines = content.split('\n').filter((line) => line.trim());
-      if (lines.length < 2) return { accounts: [], existing: [], new: [] };
 
-      const headers = lines[0].split(',').map((h) => h.trim().replace(/"/g, ''));
-
-      for (let i = 1; i < lines.length; i++) {
-        const values = lines[i].match(/(".*?"|[^,]+)/g) || [];
-        const account: any = {};
-
-        headers.forEach((header, index) => {
-          const value = values[index]?.trim().replace(/^"|"$/g, '') || '';
-
-          if (value) {
-            account[header] = value;
-          }
-        });
-
-        importedAccounts.push(account);
-      }
-    }
+    // Read, parsed and normalized on the worker pool; only the login lookups happen here
+    const importedAccounts = await workerPool.run(
+      'parseAccountFile',
+      { filePath, format },
+      { onProgress }
+    );
 
     const existing: string[] = [];
     const newAccounts: string[] = [];
 
     for (const account of importedAccounts) {
       if (account.login) {
-        const existingAccount = this.accounts.find((a) => a.login === account.login);
-        if (existingAccount) {
+        if (this.accounts.hasLogin(account.login)) {
           existing.push(account.login);
         } else {
           newAccounts.push(account.login);
@@ -303,39 +403,80 @@ export class AccountStorage {
     };
   }
 
-  async importSelectedAccounts(selectedAccounts: Partial<Account>[]): Promise<{
-    savedAccounts: Account[];
-    errors: { login: string; error: string }[];
-  }> {
+  // Validates a whole batch against the login index, applies every valid entry in one
+  // synchronous step and persists once. In upsert mode an entry whose login already exists is
+  // merged into that account instead of being rejected.
+  async applyAccountBatch(
+    inputs: Partial<Account>[],
+    options: { mode?: AccountBatchMode } = {}
+  ): Promise<AccountBatchResult> {
+    await this.ready;
+    const mode = options.mode ?? 'insert';
     const savedAccounts: Account[] = [];
+    const updatedAccounts: Account[] = [];
     const errors: { login: string; error: string }[] = [];
+    const batchLogins = new Set<string>();
 
-    for (const account of selectedAccounts) {
-      try {
-        // Debug before saving
-        if (account.characterName) {
-          console.log(
-            `📥 Processing import for ${account.login} with character: "${account.characterName}"`
-          );
-        }
+    for (const input of inputs) {
+      // Ids and runtime-only fields from the source are never trusted
+      const { id, isRunning, sourceBatchFile, ...fields } = input;
+      const login = fields.login || 'Unknown';
+
+      const validationErrors = validateAccount(fields);
+      if (validationErrors.length > 0) {
+        errors.push({ login, error: validationErrors.join(', ') });
+        continue;
+      }
+      if (batchLogins.has(fields.login!)) {
+        errors.push({ login, error: 'Duplicate login in import' });
+        continue;
+      }
+      batchLogins.add(fields.login!);
+
+      const existing = this.accounts.getByLogin(fields.login!);
+      if (!existing) {
+        savedAccounts.push({ ...fields, id: generateAccountId(), isRunning: false } as Account);
+      } else if (mode === 'upsert') {
+        updatedAccounts.push({ ...existing, ...definedFields(fields) });
+      } else {
+        errors.push({ login, error: 'An account with this login already exists' });
+      }
+    }
 
-        // Remove id and runtime-only fields to ensure accounts are treated as new
-        const { id, isRunning, sourceBatchFile, ...accountToImport } = account;
+    const changed = [...savedAccounts, ...updatedAccounts];
+    if (changed.length === 0) {
+      return { savedAccounts, updatedAccounts, errors };
+    }
 
-        const saved = await this.saveAccount(accountToImport);
-        savedAccounts.push(saved);
-      } catch (error: any) {
-        const errorMsg = error.message || 'Unknown error';
-        errors.push({ login: account.login || 'Unknown', error: errorMsg });
+    for (const account of changed) {
+      this.accounts.set(account);
+      this.markChanged(account.id);
+      if (account.originalBatchFilePath) {
+        this.batchFiles.invalidate(account.originalBatchFilePath);
       }
     }
 
-    // Force immediate save to disk after import to ensure data is available
-    if (savedAccounts.length > 0) {
-      await this.saveAccountsToDisk();
+    // One snapshot write for the whole batch rather than a journal record per account
+    try {
+      await this.persistence.compact();
+    } catch (error) {
+      console.error('💾 Batch snapshot failed, journaling instead:', error);
+      changed.forEach((account) => this.persistence.recordPut(account));
+      await this.persistence.flush();
     }
 
-    return { savedAccounts, errors };
+    console.log(
+      `📥 Applied batch: ${savedAccounts.length} added, ${updatedAccounts.length} updated, ` +
+        `${errors.length} rejected`
+    );
+    return { savedAccounts, updatedAccounts, errors };
+  }
+
+  async importSelectedAccounts(
+    selectedAccounts: Partial<Account>[],
+    mode: AccountBatchMode = 'insert'
+  ): Promise<AccountBatchResult> {
+    return this.applyAccountBatch(selectedAccounts, { mode });
   }
 
   async importAccounts(filePath: string, format: 'json' | 'csv'): Promise<Account[]> {
@@ -345,13 +486,28 @@ export class AccountStorage {
   }
 
   destroy(): void {
-    // Clear any pending save timeout to prevent memory leaks
-    if (this.saveTimeout) {
-      clearTimeout(this.saveTimeout);
-      this.saveTimeout = null;
+    // Write out anything still waiting for the debounced journal flush
+    this.persistence.flushSync();
+
+    if (this.rosterTimer) {
+      clearTimeout(this.rosterTimer);
+      this.rosterTimer = null;
     }
 
-    // Clear accounts array to free memory
-    this.accounts = [];
+    // Clear accounts and indexes to free memory
+    this.accounts.clear();
+    this.batchFiles.destroy();
+    this.removeAllListeners();
+  }
+}
+
+// Fields present in an import, so a merge does not blank out what the file left empty
+function definedFields(fields: Partial<Account>): Partial<Account> {
+  const result: Partial<Account> = {};
+  for (const [key, value] of Object.entries(fields)) {
+    if (value !== undefined && value !== '') {
+      (result as any)[key] = value;
+    }
   }
+  return result;
 }
@@ -0,0 +1,223 @@
+import { Account } from '../../shared/types';
+
+export type BatchFileEncoding = 'utf-8' | 'windows-1251' | 'ibm866';
+
+// Upper halves (0x80-0xFF) of the two single-byte code pages launcher files are written in
+const CP1251_HIGH =
+  'ЂЃ‚ѓ„…†‡€‰Љ‹ЊЌЋЏђ‘’“”•–—�™љ›њќћџ' +
+  ' ЎўЈ¤Ґ¦§Ё©Є«¬­®Ї°±Ііґµ¶·ё№є»јЅѕї' +
+  'АБВГДЕЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯабвгдежзийклмнопрстуфхцчшщъыьэюя';
+
+const CP866_HIGH =
+  'АБВГДЕЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯабвгдежзийклмноп' +
+  '░▒▓│┤╡╢╖╕╣║╗╝╜╛┐└┴┬├─┼╞╟╚╔╩╦╠═╬╧╨╤╥╙╘╒╓╫╪┘┌█▄▌▐▀' +
+  'рстуфхцчшщъыьэюяЁёЄєЇїЎў°∙·√№¤■ ';
+
+const HIGH_TABLES: Record<Exclude<BatchFileEncoding, 'utf-8'>, string> = {
+  'windows-1251': CP1251_HIGH,
+  ibm866: CP866_HIGH,
+};
+
+// Decodes launcher bytes, detecting the encoding from the bytes themselves so a file is
+// read and decoded exactly once. Valid UTF-8 wins; otherwise the Cyrillic code page whose
+// letter ranges cover more of the high bytes is chosen.
+export function decodeBatchFile(bytes: Uint8Array): { text: string; encoding: BatchFileEncoding } {
+  if (bytes.length >= 3 && bytes[0] === 0xef && bytes[1] === 0xbb && bytes[2] === 0xbf) {
+    return { text: new TextDecoder('utf-8').decode(bytes.subarray(3)), encoding: 'utf-8' };
+  }
+
+  let hasHighBytes = false;
+  for (let i = 0; i < bytes.length; i++) {
+    if (bytes[i] >= 0x80) {
+      hasHighBytes = true;
+      break;
+    }
+  }
+
+  if (!hasHighBytes) {
+    return { text: decodeAscii(bytes), encoding: 'utf-8' };
+  }
+
+  try {
+    return { text: new TextDecoder('utf-8', { fatal: true }).decode(bytes), encoding: 'utf-8' };
+  } catch {
+    // Not UTF-8 - fall through to code page detection
+  }
+
+  const encoding = detectCodePage(bytes);
+  return { text: decodeSingleByte(bytes, encoding), encoding };
+}
+
+function detectCodePage(bytes: Uint8Array): 'windows-1251' | 'ibm866' {
+  let cp1251Letters = 0;
+  let cp866Letters = 0;
+
+  for (let i = 0; i < bytes.length; i++) {
+    const b = bytes[i];
+    if (b < 0x80) {
+      continue;
+    }
+    if (b >= 0xc0 || b === 0xa8 || b === 0xb8) {
+      cp1251Letters++;
+    }
+    if (b <= 0xaf || (b >= 0xe0 && b <= 0xf1)) {
+      cp866Letters++;
+    }
+  }
+
+  return cp866Letters > cp1251Letters ? 'ibm866' : 'windows-1251';
+}
+
+function decodeAscii(bytes: Uint8Array): string {
+  let text = '';
+  for (let i = 0; i < bytes.length; i += 8192) {
+    text += String.fromCharCode(...bytes.subarray(i, i + 8192));
+  }
+  return text;
+}
+
+function decodeSingleByte(bytes: Uint8Array, encoding: 'windows-1251' | 'ibm866'): string {
+  const high = HIGH_TABLES[encoding];
+  const chars: string[] = new Array(bytes.length);
+  for (let i = 0; i < bytes.length; i++) {
+    const b = bytes[i];
+    chars[i] = b < 0x80 ? String.fromCharCode(b) : high[b - 0x80];
+  }
+  return chars.join('');
+}
+
+type CommentField = 'account' | 'server' | 'description' | 'owner' | 'character';
+const COMMENT_FIELDS = new Set<string>(['account', 'server', 'description', 'owner', 'character']);
+
+// Extracts every account field in one pass over the lines. Command-line arguments
+// (user:, pwd:, server:, role:) take precedence over the REM comments written next to them;
+// for each field the first occurrence wins.
+export function parseBatchContent(content: string): Partial<Account> {
+  let login: string | undefined;
+  let password: string | undefined;
+  let server: string | undefined;
+  let role: string | undefined;
+  const comments: Partial<Record<CommentField, string>> = {};
+
+  let lineStart = 0;
+  while (lineStart <= content.length) {
+    let lineEnd = content.indexOf('\n', lineStart);
+    if (lineEnd === -1) {
+      lineEnd = content.length;
+    }
+    const line = content.substring(lineStart, lineEnd);
+    lineStart = lineEnd + 1;
+
+    const comment = matchCommentField(line);
+    if (comment && !(comment.field in comments)) {
+      comments[comment.field] = comment.value;
+    }
+
+    // Arguments are whitespace-separated tokens of the form key:value
+    let i = 0;
+    while (i < line.length) {
+      while (i < line.length && isWhitespace(line.charCodeAt(i))) i++;
+      const tokenStart = i;
+      while (i < line.length && !isWhitespace(line.charCodeAt(i))) i++;
+      if (i === tokenStart) {
+        continue;
+      }
+
+      const colon = line.indexOf(':', tokenStart);
+      if (colon === -1 || colon >= i) {
+        continue;
+      }
+
+      const key = line.substring(tokenStart, colon).toLowerCase();
+      const value = line.substring(colon + 1, i);
+      if (key === 'role' && role === undefined) {
+        role = value; // An empty role: still shadows later ones, as with the old regex scan
+      } else if (!value) {
+        continue;
+      } else if (key === 'user' && login === undefined) {
+        login = value;
+      } else if (key === 'pwd' && password === undefined) {
+        password = value;
+      } else if (key === 'server' && server === undefined) {
+        server = value;
+      }
+    }
+  }
+
+  const account: Partial<Account> = {};
+
+  const resolvedLogin = login ?? comments.account;
+  if (resolvedLogin) {
+    account.login = resolvedLogin;
+  }
+  if (password) {
+    account.password = password;
+  }
+
+  // Unknown servers default to Main, as does a missing server
+  const resolvedServer = server ?? comments.server;
+  account.server = resolvedServer === 'X' ? 'X' : 'Main';
+
+  if (comments.description) {
+    account.description = comments.description;
+  }
+  if (comments.owner) {
+    account.owner = comments.owner;
+  }
+
+  const characterName = role || comments.character;
+  if (characterName) {
+    account.characterName = characterName;
+  }
+
+  return account;
+}
+
+// Matches `REM Key: value` (also `@REM` and `::`) for the keys launchers are annotated with
+function matchCommentField(line: string): { field: CommentField; value: string } | null {
+  let i = 0;
+  while (i < line.length && isWhitespace(line.charCodeAt(i))) i++;
+
+  if (line.startsWith('::', i)) {
+    i += 2;
+  } else {
+    if (line[i] === '@') i++;
+    if (line.substring(i, i + 3).toLowerCase() !== 'rem') {
+      return null;
+    }
+    i += 3;
+    if (i >= line.length || !isWhitespace(line.charCodeAt(i))) {
+      return null;
+    }
+  }
+
+  while (i < line.length && isWhitespace(line.charCodeAt(i))) i++;
+  const colon = line.indexOf(':', i);
+  if (colon === -1) {
+    return null;
+  }
+
+  const field = line.substring(i, colon).toLowerCase();
+  if (!COMMENT_FIELDS.has(field)) {
+    return null;
+  }
+
+  const value = line.substring(colon + 1).trim();
+  return value ? { field: field as CommentField, value } : null;
+}
+
+function isWhitespace(code: number): boolean {
+  return code === 0x20 || code === 0x09 || code === 0x0d || code === 0x0b || code === 0x0c;
+}
+
+// ElementClient.exe command line for an account, shared by direct launches and launchers
+export function buildLaunchArguments(
+  account: Pick<Account, 'login' | 'password'> & Partial<Account>
+): string[] {
+  const args = ['startbypatcher', 'nocheck', `user:${account.login}`, `pwd:${account.password}`];
+  if (account.characterName && account.characterName.trim()) {
+    args.push(`role:${account.characterName}`);
+  }
+  args.push('rendernofocus');
+  return args;
+}
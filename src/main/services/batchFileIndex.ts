@@ -0,0 +1,126 @@
+import * as path from 'path';
+import * as fs from 'fs/promises';
+import { createHash } from 'crypto';
+import { Account } from '../../shared/types';
+
+export interface BatchFileFingerprint {
+  mtimeMs: number;
+  size: number;
+  hash: string; // sha1 of the file bytes
+  account: Partial<Account>; // Parse result for those bytes; the password is never saved
+  credentials?: boolean; // The parse found a password, so the file must be re-read after a load
+}
+
+interface IndexFile {
+  version: number;
+  entries: Record<string, BatchFileFingerprint>;
+}
+
+const INDEX_VERSION = 2; // Version 1 saved passwords
+
+// Remembers what every scanned launcher parsed to, keyed by path, so rescans only read files
+// whose mtime or size moved and only re-parse files whose bytes actually changed. Passwords
+// stay in memory for the session; batch-index.json must not become a second credential store.
+export class BatchFileIndex {
+  private indexPath: string;
+  private entries: Map<string, BatchFileFingerprint> = new Map();
+  private loaded: Promise<void> | null = null;
+  private dirty = false;
+
+  constructor(indexPath: string) {
+    this.indexPath = indexPath;
+  }
+
+  load(): Promise<void> {
+    if (!this.loaded) {
+      this.loaded = this.readIndex();
+    }
+    return this.loaded;
+  }
+
+  private async readIndex(): Promise<void> {
+    try {
+      const data: IndexFile = JSON.parse(await fs.readFile(this.indexPath, 'utf-8'));
+      if (data.version === INDEX_VERSION && data.entries) {
+        this.entries = new Map(Object.entries(data.entries));
+      } else {
+        await fs.unlink(this.indexPath); // An older index holding passwords
+      }
+    } catch (error: any) {
+      if (error.code !== 'ENOENT') {
+        console.warn('📇 Ignoring unreadable batch file index:', error.message);
+      }
+    }
+  }
+
+  get(filePath: string): BatchFileFingerprint | undefined {
+    return this.entries.get(toKey(filePath));
+  }
+
+  // A fingerprint loaded from disk has lost its password and cannot serve the account alone
+  static isComplete(fingerprint: BatchFileFingerprint): boolean {
+    return !fingerprint.credentials || fingerprint.account.password !== undefined;
+  }
+
+  set(filePath: string, fingerprint: BatchFileFingerprint): void {
+    const credentials = fingerprint.credentials ?? !!fingerprint.account.password;
+    this.entries.set(toKey(filePath), { ...fingerprint, credentials });
+    this.dirty = true;
+  }
+
+  // Drops entries inside a folder that are not in `keep`, returning the dropped paths
+  retainUnder(folderPath: string, keep: Set<string>): string[] {
+    const prefix = toKey(folderPath).replace(/[\\/]+$/, '') + path.sep;
+    const keepKeys = new Set(Array.from(keep, toKey));
+    const removed: string[] = [];
+    for (const [key, fingerprint] of this.entries) {
+      if (key.startsWith(prefix) && !keepKeys.has(key)) {
+        this.entries.delete(key);
+        removed.push(fingerprint.account.sourceBatchFile ?? key);
+      }
+    }
+    if (removed.length > 0) {
+      this.dirty = true;
+    }
+    return removed;
+  }
+
+  get size(): number {
+    return this.entries.size;
+  }
+
+  // Writes the index atomically; a no-op when nothing changed since the last save
+  async save(): Promise<void> {
+    if (!this.dirty) {
+      return;
+    }
+    this.dirty = false;
+
+    const entries: Record<string, BatchFileFingerprint> = {};
+    for (const [key, fingerprint] of this.entries) {
+      const account = { ...fingerprint.account };
+      delete account.password;
+      entries[key] = { ...fingerprint, account };
+    }
+    const data: IndexFile = { version: INDEX_VERSION, entries };
+    const tempPath = `${this.indexPath}.tmp`;
+    try {
+      await fs.mkdir(path.dirname(this.indexPath), { recursive: true });
+      await fs.writeFile(tempPath, JSON.stringify(data), 'utf-8');
+      await fs.rename(tempPath, this.indexPath);
+    } catch (error) {
+      this.dirty = true;
+      console.error('📇 Could not save batch file index:', error);
+    }
+  }
+}
+
+export function hashBytes(bytes: Uint8Array): string {
+  return createHash('sha1').update(bytes).digest('hex');
+}
+
+// Windows paths are case-insensitive
+function toKey(filePath: string): string {
+  const resolved = path.resolve(filePath);
+  return process.platform === 'win32' ? resolved.toLowerCase() : resolved;
+}
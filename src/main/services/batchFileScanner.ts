@@ -2,155 +2,279 @@ import * as path from 'path';
 import * as fs from 'fs/promises';
 import { Account } from '../../shared/types';
 import { generateAccountId } from '../../shared/utils/validation';
+import { BatchFileIndex, hashBytes } from './batchFileIndex';
+import { transferableBytes, workerPool } from './workerPool';
+
+export interface ScanOptions {
+  maxDepth?: number; // Directory levels below the root to descend into
+  maxFiles?: number; // Stop after this many accounts have been found
+  concurrency?: number; // Directory reads and file parses in flight at once
+  signal?: AbortSignal; // Aborting stops queuing new work; results found so far are returned
+  onAccounts?: (accounts: Partial<Account>[]) => void; // Streams each parsed account as found
+}
+
+export interface ScanStats {
+  directoriesScanned: number;
+  filesParsed: number;
+  accountsFound: number;
+  cancelled: boolean;
+  filesReused: number; // Served from the fingerprint index without parsing
+}
+
+// What changed since the previous scan of the same folder, by launcher path
+export interface ScanDiff {
+  added: string[];
+  modified: string[];
+  removed: string[];
+  unchanged: number;
+}
+
+type ScanJob = { type: 'dir'; path: string; depth: number } | { type: 'file'; path: string };
 
 export class BatchFileScanner {
-  private readonly MAX_SCAN_DEPTH = 5; // Limit recursion depth to prevent stack overflow
-  private readonly MAX_FILES_TO_SCAN = 1000; // Limit total files scanned to prevent memory issues
+  static readonly DEFAULT_MAX_DEPTH = 5; // Limit recursion depth on deep folder trees
+  static readonly DEFAULT_MAX_FILES = 1000; // Limit total accounts to prevent memory issues
+  static readonly DEFAULT_CONCURRENCY = 8;
+
+  private lastStats: ScanStats = {
+    directoriesScanned: 0,
+    filesParsed: 0,
+    accountsFound: 0,
+    cancelled: false,
+    filesReused: 0,
+  };
+  private lastDiff: ScanDiff | null = null;
+  private index: BatchFileIndex | null;
 
-  async scanFolder(folderPath: string): Promise<Partial<Account>[]> {
+  // With an index, rescans stat files and only re-read or re-parse the ones that changed
+  constructor(index: BatchFileIndex | null = null) {
+    this.index = index;
+  }
+
+  async scanFolder(folderPath: string, options: ScanOptions = {}): Promise<Partial<Account>[]> {
     const accounts: Partial<Account>[] = [];
+    this.lastDiff = null;
 
     try {
-      await this.scanDirectory(folderPath, accounts, 0);
+      await this.index?.load();
+      await this.runScan(folderPath, accounts, options);
     } catch (error) {
       console.error('Error scanning folder:', error);
       // Return empty array on error to match test expectations
       return [];
+    } finally {
+      await this.index?.save();
     }
 
     return accounts;
   }
 
-  private async scanDirectory(
-    dirPath: string,
+  getLastScanStats(): ScanStats {
+    return { ...this.lastStats };
+  }
+
+  // Null without an index, or when the last scan failed
+  getLastScanDiff(): ScanDiff | null {
+    return this.lastDiff;
+  }
+
+  // Walks the tree through a bounded queue: directory reads and file parses share
+  // `concurrency` slots, so slow network shares are read in parallel instead of one by one
+  private runScan(
+    rootPath: string,
     accounts: Partial<Account>[],
-    depth: number
+    options: ScanOptions
   ): Promise<void> {
-    // Prevent deep recursion that could cause stack overflow
-    if (depth >= this.MAX_SCAN_DEPTH) {
-      console.warn(`Reached maximum scan depth (${this.MAX_SCAN_DEPTH}) at: ${dirPath}`);
-      return;
-    }
+    const maxDepth = options.maxDepth ?? BatchFileScanner.DEFAULT_MAX_DEPTH;
+    const maxFiles = options.maxFiles ?? BatchFileScanner.DEFAULT_MAX_FILES;
+    const concurrency = Math.max(1, options.concurrency ?? BatchFileScanner.DEFAULT_CONCURRENCY);
+    const stats: ScanStats = {
+      directoriesScanned: 0,
+      filesParsed: 0,
+      accountsFound: 0,
+      cancelled: false,
+      filesReused: 0,
+    };
+    this.lastStats = stats;
+    const diff: ScanDiff = { added: [], modified: [], removed: [], unchanged: 0 };
+    const seen = new Set<string>();
 
-    // Prevent scanning too many files to avoid memory issues
-    if (accounts.length >= this.MAX_FILES_TO_SCAN) {
-      console.warn(`Reached maximum file scan limit (${this.MAX_FILES_TO_SCAN}), stopping scan`);
-      return;
-    }
-
-    let entries;
-    try {
-      entries = await fs.readdir(dirPath, { withFileTypes: true });
-    } catch (error) {
-      console.warn(`Cannot read directory ${dirPath}:`, error);
-      // Do not throw, just return to upper logic
-      return;
-    }
+    const queue: ScanJob[] = [{ type: 'dir', path: rootPath, depth: 0 }];
+    let active = 0;
+    let limitLogged = false;
 
-    for (const entry of entries) {
-      // Check limits again in the loop
-      if (accounts.length >= this.MAX_FILES_TO_SCAN) {
-        break;
+    const shouldStop = (): boolean => {
+      if (options.signal?.aborted) {
+        stats.cancelled = true;
+        return true;
       }
+      if (accounts.length >= maxFiles) {
+        if (!limitLogged) {
+          console.warn(`Reached maximum file scan limit (${maxFiles}), stopping scan`);
+          limitLogged = true;
+        }
+        return true;
+      }
+      return false;
+    };
 
-      const fullPath = path.join(dirPath, entry.name);
+    const runJob = async (job: ScanJob): Promise<void> => {
+      if (job.type === 'dir') {
+        const children = await this.readDirectory(job.path, job.depth, maxDepth);
+        stats.directoriesScanned++;
+        queue.push(...children);
+        return;
+      }
 
-      if (entry.isDirectory()) {
-        await this.scanDirectory(fullPath, accounts, depth + 1);
-      } else if (entry.isFile() && entry.name.toLowerCase().endsWith('.bat')) {
-        try {
-          const account = await this.parseBatchFile(fullPath);
-          if (account && account.login && account.password) {
-            accounts.push(account);
-          }
-        } catch (error) {
-          console.warn(`Error processing batch file ${fullPath}:`, error);
-          // Continue processing other files even if one fails
+      try {
+        seen.add(job.path);
+        const account = this.index
+          ? await this.parseIndexedFile(job.path, diff, stats)
+          : await this.parseBatchFile(job.path);
+        stats.filesParsed++;
+        if (account && account.login && account.password && accounts.length < maxFiles) {
+          accounts.push(account);
+          stats.accountsFound++;
+          options.onAccounts?.([account]);
         }
+      } catch (error) {
+        console.warn(`Error processing batch file ${job.path}:`, error);
+        // Continue processing other files even if one fails
       }
-    }
-  }
+    };
 
-  private async parseBatchFile(filePath: string): Promise<Partial<Account> | null> {
-    try {
-      // Read as UTF-8 first
-      const content = await fs.readFile(filePath, 'utf8');
+    return new Promise((resolve) => {
+      const pump = () => {
+        if (shouldStop()) {
+          queue.length = 0;
+        }
 
-      const account: Partial<Account> = {};
+        while (active < concurrency && queue.length > 0) {
+          const job = queue.shift() as ScanJob;
+          active++;
+          runJob(job).finally(() => {
+            active--;
+            pump();
+          });
+        }
 
-      const userMatch = content.match(/user:([^\s]+)/i);
-      if (userMatch) {
-        account.login = userMatch[1];
-      }
+        if (active === 0 && queue.length === 0) {
+          this.finishDiff(rootPath, seen, diff, !stats.cancelled && accounts.length < maxFiles);
+          resolve();
+        }
+      };
 
-      const pwdMatch = content.match(/pwd:([^\s]+)/i);
-      if (pwdMatch) {
-        account.password = pwdMatch[1];
-      }
+      pump();
+    });
+  }
 
-      const serverMatch = content.match(/server:([^\s]+)/i);
-      if (serverMatch) {
-        const serverValue = serverMatch[1];
-        if (serverValue === 'Main' || serverValue === 'X') {
-          account.server = serverValue;
-        } else {
-          // Default to Main for unknown servers
-          account.server = 'Main';
-        }
-      }
+  private async readDirectory(
+    dirPath: string,
+    depth: number,
+    maxDepth: number
+  ): Promise<ScanJob[]> {
+    let entries;
+    try {
+      entries = await fs.readdir(dirPath, { withFileTypes: true });
+    } catch (error) {
+      console.warn(`Cannot read directory ${dirPath}:`, error);
+      // Do not throw, just return to upper logic
+      return [];
+    }
 
-      const accountComment = content.match(/REM\s+Account:\s*(.+)/i);
-      if (accountComment && !account.login) {
-        account.login = accountComment[1].trim();
-      }
+    const jobs: ScanJob[] = [];
+    for (const entry of entries) {
+      const fullPath = path.join(dirPath, entry.name);
 
-      const serverComment = content.match(/REM\s+Server:\s*(.+)/i);
-      if (serverComment && !account.server) {
-        const serverValue = serverComment[1].trim();
-        if (serverValue === 'Main' || serverValue === 'X') {
-          account.server = serverValue;
+      if (entry.isDirectory()) {
+        // Prevent descending into very deep trees
+        if (depth + 1 >= maxDepth) {
+          console.warn(`Reached maximum scan depth (${maxDepth}) at: ${fullPath}`);
         } else {
-          // Default to Main for unknown servers
-          account.server = 'Main';
+          jobs.push({ type: 'dir', path: fullPath, depth: depth + 1 });
         }
+      } else if (entry.isFile() && entry.name.toLowerCase().endsWith('.bat')) {
+        jobs.push({ type: 'file', path: fullPath });
       }
+    }
 
-      // Parse description comment
-      const descriptionComment = content.match(/REM\s+Description:\s*(.+)/i);
-      if (descriptionComment) {
-        account.description = descriptionComment[1].trim();
-      }
+    // Files first so results start streaming before the next directory level is listed
+    return jobs.sort((a, b) => (a.type === b.type ? 0 : a.type === 'file' ? -1 : 1));
+  }
 
-      // Parse owner comment
-      const ownerComment = content.match(/REM\s+Owner:\s*(.+)/i);
-      if (ownerComment) {
-        account.owner = ownerComment[1].trim();
-      }
+  // Unchanged mtime and size reuse the indexed parse without reading the file; changed
+  // metadata with identical bytes (a touch or copy) reuses it after hashing. Entries loaded
+  // from disk carry no password, so account launchers are re-parsed once per session.
+  private async parseIndexedFile(
+    filePath: string,
+    diff: ScanDiff,
+    stats: ScanStats
+  ): Promise<Partial<Account> | null> {
+    const index = this.index as BatchFileIndex;
+    const stat = await fs.stat(filePath);
+    const known = index.get(filePath);
+    const reusable = known !== undefined && BatchFileIndex.isComplete(known);
 
-      // Parse character name from role parameter or comment
-      const roleMatch = content.match(/role:([^\s]*)/i);
-      if (roleMatch && roleMatch[1]) {
-        account.characterName = roleMatch[1];
-      }
+    if (reusable && known.mtimeMs === stat.mtimeMs && known.size === stat.size) {
+      diff.unchanged++;
+      stats.filesReused++;
+      return { ...known.account };
+    }
 
-      const characterComment = content.match(/REM\s+Character:\s*(.+)/i);
-      if (characterComment && !account.characterName) {
-        account.characterName = characterComment[1].trim();
-      }
+    const bytes = await fs.readFile(filePath);
+    const hash = hashBytes(bytes);
+    if (reusable && known.hash === hash) {
+      index.set(filePath, { ...known, mtimeMs: stat.mtimeMs, size: stat.size });
+      diff.unchanged++;
+      stats.filesReused++;
+      return { ...known.account };
+    }
 
-      // Ensure server is set (default to Main if not specified)
-      if (!account.server) {
-        account.server = 'Main';
-      }
+    const account = await this.parseBatchBytes(filePath, bytes);
+    index.set(filePath, { mtimeMs: stat.mtimeMs, size: stat.size, hash, account });
+    if (!known) {
+      diff.added.push(filePath);
+    } else if (known.hash === hash) {
+      diff.unchanged++;
+    } else {
+      diff.modified.push(filePath);
+    }
+    return { ...account };
+  }
 
-      // Store the source batch file path for reference
-      account.sourceBatchFile = filePath;
-      account.originalBatchFilePath = filePath;
+  // Launchers absent from a complete scan are gone; a cancelled or truncated scan cannot tell
+  private finishDiff(rootPath: string, seen: Set<string>, diff: ScanDiff, complete: boolean) {
+    if (!this.index) {
+      return;
+    }
+    if (complete) {
+      diff.removed = this.index.retainUnder(rootPath, seen);
+    }
+    this.lastDiff = diff;
+  }
 
-      return account;
+  private async parseBatchFile(filePath: string): Promise<Partial<Account> | null> {
+    try {
+      return await this.parseBatchBytes(filePath, await fs.readFile(filePath));
     } catch (error) {
       console.error(`Error parsing batch file ${filePath}:`, error);
       return null;
     }
   }
+
+  // Decoded and parsed on the worker pool; the file's bytes are moved there, not copied
+  private async parseBatchBytes(filePath: string, bytes: Uint8Array): Promise<Partial<Account>> {
+    const owned = transferableBytes(bytes);
+    const account = await workerPool.run(
+      'parseBatchFile',
+      { bytes: owned },
+      { transfer: [owned.buffer as ArrayBuffer] }
+    );
+
+    // Store the source batch file path for reference
+    account.sourceBatchFile = filePath;
+    account.originalBatchFilePath = filePath;
+
+    return account;
+  }
 }
@@ -0,0 +1,103 @@
+import * as path from 'path';
+import * as fs from 'fs/promises';
+import { renameSync, writeFileSync } from 'fs';
+
+// Writes whatever `serialize` returns to one file, at most once per `delay`. Each write goes
+// to a temp file that is then renamed over the target, so a crash mid-write leaves the
+// previous contents intact. Changes made while a write is running are picked up by one more.
+export class CoalescedFileWriter {
+  private filePath: string;
+  private serialize: () => string;
+  private readonly delay: number;
+  private timer: NodeJS.Timeout | null = null;
+  private dirty = false;
+  private writing: Promise<void> | null = null;
+  private closed = false; // Set by flushSync; a write still in flight must not replace its file
+
+  constructor(filePath: string, serialize: () => string, delay = 500) {
+    this.filePath = filePath;
+    this.serialize = serialize;
+    this.delay = delay;
+  }
+
+  schedule(): void {
+    this.dirty = true;
+    if (!this.timer && !this.writing) {
+      this.timer = setTimeout(() => {
+        this.timer = null;
+        void this.writeNow();
+      }, this.delay);
+    }
+  }
+
+  // Writes pending changes right away and resolves once they are on disk
+  async flush(): Promise<void> {
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+    if (this.writing) {
+      await this.writing;
+    }
+    if (this.dirty) {
+      await this.writeNow();
+    }
+  }
+
+  // Synchronous last-chance write for shutdown, when async writes may never complete
+  flushSync(): void {
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+    if (!this.dirty) {
+      return;
+    }
+
+    this.dirty = false;
+    this.closed = true;
+    const tempPath = `${this.filePath}.sync.tmp`;
+    try {
+      writeFileSync(tempPath, this.serialize(), 'utf-8');
+      renameSync(tempPath, this.filePath);
+    } catch (error) {
+      console.error(`💾 Could not write ${path.basename(this.filePath)} on shutdown:`, error);
+    }
+  }
+
+  get pending(): boolean {
+    return this.dirty || this.writing !== null;
+  }
+
+  private writeNow(): Promise<void> {
+    this.writing = this.write().then((written) => {
+      this.writing = null;
+      // Changes that arrived during a successful write; a failed one waits for the next change
+      if (written && this.dirty && !this.timer) {
+        this.schedule();
+      }
+    });
+    return this.writing;
+  }
+
+  private async write(): Promise<boolean> {
+    if (!this.dirty) {
+      return true;
+    }
+    this.dirty = false;
+
+    const tempPath = `${this.filePath}.tmp`;
+    try {
+      await fs.mkdir(path.dirname(this.filePath), { recursive: true });
+      await fs.writeFile(tempPath, this.serialize(), 'utf-8');
+      if (!this.closed) {
+        await fs.rename(tempPath, this.filePath);
+      }
+      return true;
+    } catch (error) {
+      this.dirty = true;
+      console.error(`💾 Could not write ${path.basename(this.filePath)}:`, error);
+      return false;
+    }
+  }
+}
@@ -0,0 +1,145 @@
+import { EventEmitter } from 'events';
+import * as path from 'path';
+import * as fs from 'fs';
+
+// Remembers whether files exist and keeps the answer current with one fs.watch per parent
+// directory, so repeated queries cost nothing after the first fs.access.
+export class FileExistenceCache extends EventEmitter {
+  private entries: Map<string, boolean> = new Map();
+  private watchers: Map<string, fs.FSWatcher> = new Map();
+  private trackedByDir: Map<string, Map<string, string>> = new Map(); // dir -> base name key -> path
+
+  // Returns existence for every path, hitting the filesystem only for paths not seen before
+  async resolve(filePaths: string[]): Promise<Map<string, boolean>> {
+    const result = new Map<string, boolean>();
+    const unknown: string[] = [];
+    for (const filePath of filePaths) {
+      const cached = this.entries.get(toKey(filePath));
+      if (cached === undefined) {
+        unknown.push(filePath);
+      } else {
+        result.set(filePath, cached);
+      }
+    }
+
+    await Promise.all(
+      unknown.map(async (filePath) => {
+        const exists = await fileExists(filePath);
+        result.set(filePath, exists);
+
+        // Only cache what a watcher will keep current
+        if (this.track(filePath)) {
+          this.entries.set(toKey(filePath), exists);
+        }
+      })
+    );
+
+    return result;
+  }
+
+  get(filePath: string): boolean | undefined {
+    return this.entries.get(toKey(filePath));
+  }
+
+  // Drops a path so the next resolve() checks the filesystem again
+  invalidate(filePath: string): void {
+    this.entries.delete(toKey(filePath));
+  }
+
+  private track(filePath: string): boolean {
+    const dir = toKey(path.dirname(filePath));
+    if (!this.watchers.has(dir) && !this.watchDirectory(dir, path.dirname(filePath))) {
+      return false;
+    }
+
+    let tracked = this.trackedByDir.get(dir);
+    if (!tracked) {
+      tracked = new Map();
+      this.trackedByDir.set(dir, tracked);
+    }
+    tracked.set(toNameKey(path.basename(filePath)), filePath);
+    return true;
+  }
+
+  private watchDirectory(dir: string, dirPath: string): boolean {
+    try {
+      const watcher = fs.watch(dirPath, { persistent: false }, (_event, fileName) => {
+        const tracked = this.trackedByDir.get(dir);
+        if (!tracked) {
+          return;
+        }
+
+        if (fileName) {
+          const filePath = tracked.get(toNameKey(fileName.toString()));
+          if (filePath) {
+            this.recheck(filePath);
+          }
+        } else {
+          // Some platforms omit the name - recheck everything in the directory
+          for (const filePath of tracked.values()) {
+            this.recheck(filePath);
+          }
+        }
+      });
+
+      watcher.on('error', () => this.dropDirectory(dir));
+      this.watchers.set(dir, watcher);
+      return true;
+    } catch {
+      // Directory missing or not watchable - callers get uncached answers
+      return false;
+    }
+  }
+
+  // Without a watcher the cached answers can go stale, so forget them
+  private dropDirectory(dir: string): void {
+    this.watchers.get(dir)?.close();
+    this.watchers.delete(dir);
+
+    const tracked = this.trackedByDir.get(dir);
+    if (tracked) {
+      for (const filePath of tracked.values()) {
+        this.entries.delete(toKey(filePath));
+      }
+    }
+    this.trackedByDir.delete(dir);
+  }
+
+  private async recheck(filePath: string): Promise<void> {
+    const key = toKey(filePath);
+    const exists = await fileExists(filePath);
+    if (this.entries.get(key) !== exists) {
+      this.entries.set(key, exists);
+      this.emit('change', filePath, exists);
+    }
+  }
+
+  destroy(): void {
+    for (const watcher of this.watchers.values()) {
+      watcher.close();
+    }
+    this.watchers.clear();
+    this.trackedByDir.clear();
+    this.entries.clear();
+    this.removeAllListeners();
+  }
+}
+
+// Windows paths are case-insensitive
+function toKey(filePath: string): string {
+  const resolved = path.resolve(filePath);
+  return process.platform === 'win32' ? resolved.toLowerCase() : resolved;
+}
+
+function toNameKey(fileName: string): string {
+  return process.platform === 'win32' ? fileName.toLowerCase() : fileName;
+}
+
+async function fileExists(filePath: string): Promise<boolean> {
+  try {
+    await fs.promises.access(filePath);
+    return true;
+  } catch {
+    return false;
+  }
+}
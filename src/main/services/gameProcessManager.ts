@@ -1,29 +1,38 @@
 import { EventEmitter } from 'events';
 import { spawn, ChildProcess, exec } from 'child_process';
 import { promisify } from 'util';
-import * as path from 'path';
-import * as fs from 'fs';
 import { Account, ProcessInfo } from '../../shared/types';
 import { logger } from './loggingService';
+import { processSnapshot, selectTreeLeaf } from './processSnapshotService';
+import { LaunchPlanCache } from './launchPlanCache';
+import { metrics } from './performanceMetrics';
+import type { SettingsManager } from './settingsManager';
 
 const execAsync = promisify(exec);
 
 export class GameProcessManager extends EventEmitter {
   private processes: Map<string, ProcessInfo> = new Map();
   private processCheckInterval: NodeJS.Timeout | null = null;
-  private processCache: Map<
-    number,
-    { windowTitle: string; commandLine: string; lastChecked: number }
-  > = new Map();
   private LIGHTWEIGHT_CHECK_INTERVAL = 5000; // Quick checks interval (configurable)
-  private settingsManager: any; // Will be injected
+  private readonly ASSOCIATION_POLL_INTERVAL = 500; // Snapshot polling while a launch has no PID yet
+  private readonly ASSOCIATION_TIMEOUT = 20000; // Give up and keep the client with an unknown PID
+  private readonly TASKKILL_BATCH_SIZE = 100; // PIDs per taskkill call, well under the command line limit
+  private settingsManager: SettingsManager | undefined; // Will be injected
+  private unsubscribeSettings: (() => void) | null = null;
   private userInitiatedClosures: Set<string> = new Set(); // Track accounts closed by user action
   private accountLaunchData: Map<string, { account: Account; gamePath: string }> = new Map(); // Store launch data for restarts
+  private launchPlans: LaunchPlanCache = new LaunchPlanCache();
 
-  constructor(settingsManager?: any) {
+  constructor(settingsManager?: SettingsManager) {
     super();
     this.settingsManager = settingsManager;
     this.adjustPerformanceSettings();
+    if (settingsManager) {
+      // Re-tune monitoring as soon as the setting is saved
+      this.unsubscribeSettings = settingsManager.onChange('processMonitoringMode', () =>
+        this.updatePerformanceSettings()
+      );
+    }
     // NO MORE CONSTANT MONITORING! Only check when needed
     logger.info(
       'GameProcessManager initialized - monitoring disabled for performance',
@@ -31,15 +40,66 @@ export class GameProcessManager extends EventEmitter {
       'PROCESS_MANAGER'
     );
 
-    // Scan for existing processes on startup
-    this.scanExistingProcesses();
+    // Exit notifications from the resident snapshot host replace interval polling
+    processSnapshot.on('process-exit', this.handleProcessExitEvent);
+    processSnapshot.on('host-lost', this.handleSnapshotHostLost);
+
+    // scanExistingProcesses() runs once the window is up; see runDeferredStartup()
   }
 
+  private handleProcessExitEvent = (pid: number): void => {
+    for (const [accountId, processInfo] of this.processes.entries()) {
+      if (processInfo.pid !== pid) {
+        continue;
+      }
+
+      // A client that re-spawned itself lives on in its child - follow it instead of reporting a crash
+      const launchTime: Date | undefined = (processInfo as any).launchTime;
+      const successor = selectTreeLeaf(
+        processSnapshot.findProcessTree(pid, launchTime || new Date(0))
+      );
+      if (successor) {
+        processInfo.pid = successor.pid;
+        logger.info(
+          `${processInfo.login} moved from PID ${pid} to child PID ${successor.pid}`,
+          { accountId, pid, successor: successor.pid },
+          'PROCESS_MANAGER'
+        );
+        this.emit('status-update', accountId, true);
+        return;
+      }
+
+      // Disabled monitoring means processes stay "running" until closed manually
+      if (this.LIGHTWEIGHT_CHECK_INTERVAL === 0) {
+        return;
+      }
+
+      logger.info(
+        `Exit event received for ${processInfo.login} (PID ${pid})`,
+        { accountId, pid },
+        'PROCESS_MANAGER'
+      );
+      this.handleProcessGone(accountId, processInfo);
+      break;
+    }
+
+    if (this.processes.size === 0) {
+      this.stopCrashDetection();
+    }
+  };
+
+  private handleSnapshotHostLost = (): void => {
+    // Exits may have been missed while the host was down - reconcile once
+    if (this.processes.size > 0 && this.LIGHTWEIGHT_CHECK_INTERVAL !== 0) {
+      this.checkForCrashedProcesses();
+    }
+  };
+
   private adjustPerformanceSettings(): void {
     if (!this.settingsManager) return;
 
     try {
-      const settings = this.settingsManager.getSettings();
+      const settings = this.settingsManager.getCachedSettings();
       const mode = settings.processMonitoringMode || '3min';
 
       switch (mode) {
@@ -73,7 +133,7 @@ export class GameProcessManager extends EventEmitter {
     if (!this.settingsManager) return false;
 
     try {
-      const settings = this.settingsManager.getSettings();
+      const settings = this.settingsManager.getCachedSettings();
 
       // Auto-restart only works when monitoring is enabled (not disabled)
       const monitoringEnabled = settings.processMonitoringMode !== 'disabled';
@@ -98,6 +158,11 @@ export class GameProcessManager extends EventEmitter {
       return;
     }
 
+    if (this.processes.size > 0) {
+      // Crashes are reported immediately by exit events; the interval is only a reconciliation sweep
+      processSnapshot.startWatching();
+    }
+
     if (this.processes.size > 0 && !this.processCheckInterval) {
       console.log(`Starting crash detection with ${this.LIGHTWEIGHT_CHECK_INTERVAL}ms interval...`);
       this.processCheckInterval = setInterval(() => {
@@ -112,9 +177,15 @@ export class GameProcessManager extends EventEmitter {
       this.processCheckInterval = null;
       console.log('Stopped crash detection');
     }
+
+    if (this.processes.size === 0) {
+      // Nothing left to report exits for - release the WMI subscriptions and the host
+      processSnapshot.stopWatching();
+    }
   }
 
-  private async scanExistingProcesses(): Promise<void> {
+  // Startup process discovery (wmic/tasklist); deferred until after first paint
+  async scanExistingProcesses(): Promise<void> {
     try {
       // Scan for existing ElementClient.exe processes that might be running
       const existingProcesses = await this.getElementClientProcesses();
@@ -136,271 +207,18 @@ export class GameProcessManager extends EventEmitter {
     }
   }
 
-  private async getElementClientProcesses(): Promise<Array<{ pid: number; startTime: Date }>> {
+  private async getElementClientProcesses(
+    maxAgeMs?: number
+  ): Promise<Array<{ pid: number; startTime: Date }>> {
     if (process.platform !== 'win32') {
       return [];
     }
 
-    console.log('🔍 Starting comprehensive Perfect World process detection...');
-
-    // Try multiple detection methods and combine results
-    const allProcesses = new Map<number, { pid: number; startTime: Date; method: string }>();
-
-    // Method 1: Window-based detection (most reliable for Perfect World)
-    try {
-      const windowProcesses = await this.getProcessesByWindowTitle();
-      windowProcesses.forEach((proc) => {
-        allProcesses.set(proc.pid, { ...proc, method: 'window' });
-      });
-      console.log(`🪟 Found ${windowProcesses.length} processes by window title`);
-    } catch (error) {
-      console.warn('Window-based detection failed:', error);
-    }
-
-    // Method 2: Process name detection (multiple possible names)
-    try {
-      const nameProcesses = await this.getProcessesByExecutableName();
-      nameProcesses.forEach((proc) => {
-        if (!allProcesses.has(proc.pid)) {
-          allProcesses.set(proc.pid, { ...proc, method: 'process_name' });
-        }
-      });
-      console.log(`📋 Found ${nameProcesses.length} processes by executable name`);
-    } catch (error) {
-      console.warn('Process name detection failed:', error);
-    }
-
-    // Method 3: Fallback tasklist approach
-    if (allProcesses.size === 0) {
-      try {
-        const fallbackProcesses = await this.getElementClientProcessesFallback();
-        fallbackProcesses.forEach((proc) => {
-          allProcesses.set(proc.pid, { ...proc, method: 'tasklist_fallback' });
-        });
-        console.log(`🔄 Found ${fallbackProcesses.length} processes via fallback method`);
-      } catch (error) {
-        console.warn('Fallback detection failed:', error);
-      }
-    }
-
-    const finalProcesses = Array.from(allProcesses.values()).map(({ method, ...proc }) => proc);
-    console.log(`🎯 Total unique Perfect World processes found: ${finalProcesses.length}`);
-
-    return finalProcesses;
-  }
-
-  private async getProcessesByWindowTitle(): Promise<Array<{ pid: number; startTime: Date }>> {
-    try {
-      // Use WMI to find windows by title, then get associated process info
-      const wmiWindowQuery = `wmic process get ProcessId,Name,CreationDate /format:csv | findstr "ElementClient.exe"`;
-
-      // First, let's get all ElementClient.exe processes with their creation dates
-      const { stdout: processOutput } = await execAsync(wmiWindowQuery, {
-        timeout: 5000,
-        killSignal: 'SIGTERM',
-      });
-
-      const processes: Array<{ pid: number; startTime: Date }> = [];
-
-      if (processOutput.trim()) {
-        const lines = processOutput
-          .split('\n')
-          .filter((line) => line.trim() && line.includes('ElementClient.exe'));
-
-        for (const line of lines) {
-          const parts = line.split(',');
-          if (parts.length >= 4) {
-            const creationDate = parts[1]?.trim();
-            const processName = parts[2]?.trim();
-            const pidStr = parts[3]?.trim();
-
-            if (pidStr && !isNaN(parseInt(pidStr)) && processName === 'ElementClient.exe') {
-              const pid = parseInt(pidStr);
-              let startTime = new Date();
-
-              // Parse WMI date format: 20231025143022.000000+000
-              if (creationDate && creationDate.length >= 14) {
-                const year = parseInt(creationDate.substring(0, 4));
-                const month = parseInt(creationDate.substring(4, 6)) - 1;
-                const day = parseInt(creationDate.substring(6, 8));
-                const hour = parseInt(creationDate.substring(8, 10));
-                const minute = parseInt(creationDate.substring(10, 12));
-                const second = parseInt(creationDate.substring(12, 14));
-
-                if (!isNaN(year) && !isNaN(month) && !isNaN(day)) {
-                  startTime = new Date(year, month, day, hour, minute, second);
-                }
-              }
-
-              // Verify this process has the expected window title
-              try {
-                const windowQuery = `wmic process where "ProcessId=${pid}" get ProcessId /format:csv`;
-                const { stdout: windowCheck } = await execAsync(windowQuery, { timeout: 2000 });
-
-                if (windowCheck.includes(pid.toString())) {
-                  processes.push({ pid, startTime });
-                  console.log(
-                    `🪟 Found ElementClient.exe process PID ${pid} (started: ${startTime.toLocaleString()})`
-                  );
-
-                  // Try to get window title for verification
-                  try {
-                    const titleQuery = `powershell -Command "Get-Process -Id ${pid} | Select-Object -ExpandProperty MainWindowTitle"`;
-                    const { stdout: titleResult } = await execAsync(titleQuery, { timeout: 2000 });
-                    const windowTitle = titleResult.trim();
-                    if (windowTitle) {
-                      console.log(`   └─ Window title: "${windowTitle}"`);
-                    }
-                  } catch (titleError) {
-                    // Don't fail if we can't get window title
-                  }
-                }
-              } catch (verifyError) {
-                // If verification fails, still include the process
-                processes.push({ pid, startTime });
-                console.log(
-                  `🪟 Found ElementClient.exe process PID ${pid} (verification failed, but including)`
-                );
-              }
-            }
-          }
-        }
-      }
-
-      return processes;
-    } catch (error) {
-      console.warn('WMI window detection failed:', error);
-      return [];
-    }
-  }
-
-  private async getProcessesByExecutableName(): Promise<Array<{ pid: number; startTime: Date }>> {
-    try {
-      // Focus specifically on ElementClient.exe since you confirmed that's the correct process name
-      console.log('📋 Using WMI to detect ElementClient.exe processes...');
-
-      // Use a more robust WMI query format
-      const wmiQuery = `wmic process where "name='ElementClient.exe'" get ProcessId,CreationDate,Name /format:csv`;
-      const { stdout } = await execAsync(wmiQuery, {
-        timeout: 8000, // Longer timeout for WMI
-        killSignal: 'SIGTERM',
-      });
-
-      console.log('📋 WMI raw output:', stdout.substring(0, 200) + '...');
-
-      const processes: Array<{ pid: number; startTime: Date }> = [];
-
-      if (!stdout.trim()) {
-        console.log('📋 WMI returned empty output');
-        return processes;
-      }
-
-      // Split by lines and filter for ElementClient.exe
-      const lines = stdout.split('\n');
-      console.log(`📋 WMI returned ${lines.length} lines`);
-
-      for (const line of lines) {
-        const trimmedLine = line.trim();
-        if (!trimmedLine || !trimmedLine.includes('ElementClient.exe')) {
-          continue;
-        }
-
-        console.log('📋 Processing line:', trimmedLine);
-
-        // Parse CSV format: Node,CreationDate,Name,ProcessId
-        const parts = trimmedLine.split(',');
-        if (parts.length >= 4) {
-          const nodeName = parts[0]?.trim();
-          const creationDate = parts[1]?.trim();
-          const processName = parts[2]?.trim();
-          const pidStr = parts[3]?.trim();
-
-          console.log(
-            `📋 Parsed: node=${nodeName}, date=${creationDate}, name=${processName}, pid=${pidStr}`
-          );
-
-          if (pidStr && !isNaN(parseInt(pidStr)) && processName === 'ElementClient.exe') {
-            const pid = parseInt(pidStr);
-            let startTime = new Date();
-
-            // Parse WMI date format: 20231025143022.000000+000
-            if (creationDate && creationDate.length >= 14) {
-              try {
-                const year = parseInt(creationDate.substring(0, 4));
-                const month = parseInt(creationDate.substring(4, 6)) - 1;
-                const day = parseInt(creationDate.substring(6, 8));
-                const hour = parseInt(creationDate.substring(8, 10));
-                const minute = parseInt(creationDate.substring(10, 12));
-                const second = parseInt(creationDate.substring(12, 14));
-
-                if (!isNaN(year) && !isNaN(month) && !isNaN(day)) {
-                  startTime = new Date(year, month, day, hour, minute, second);
-                  console.log(`📋 Parsed start time: ${startTime.toLocaleString()}`);
-                }
-              } catch (dateError) {
-                console.warn('📋 Failed to parse creation date:', dateError);
-              }
-            }
-
-            processes.push({ pid, startTime });
-            console.log(`📋 ✅ Added ElementClient.exe PID ${pid} to results`);
-          }
-        }
-      }
-
-      console.log(`📋 Final WMI process count: ${processes.length}`);
-      return processes;
-    } catch (error) {
-      console.error('📋 WMI process detection failed:', error);
-      return [];
-    }
-  }
-
-  private async getElementClientProcessesFallback(): Promise<
-    Array<{ pid: number; startTime: Date }>
-  > {
-    try {
-      console.log('🔄 Using tasklist fallback for ElementClient.exe...');
-
-      const { stdout } = await execAsync(
-        `tasklist /fi "imagename eq ElementClient.exe" /fo csv /nh`,
-        { timeout: 3000 }
-      );
-      console.log('🔄 Tasklist raw output:', stdout.substring(0, 200) + '...');
+    // Served from the resident snapshot table - no per-call wmic/tasklist/powershell spawns
+    const processes = await processSnapshot.getProcesses(maxAgeMs);
+    console.log(`🎯 Perfect World processes in snapshot: ${processes.length}`);
 
-      const processes: Array<{ pid: number; startTime: Date }> = [];
-
-      if (!stdout.trim()) {
-        console.log('🔄 Tasklist returned empty output');
-        return processes;
-      }
-
-      const lines = stdout
-        .split('\n')
-        .filter((line) => line.trim() && line.includes('ElementClient.exe'));
-      console.log(`🔄 Found ${lines.length} matching lines`);
-
-      for (const line of lines) {
-        console.log('🔄 Processing line:', line.trim());
-
-        // Parse CSV format: "Image Name","PID","Session Name","Session#","Mem Usage"
-        const match = line.match(/"ElementClient\.exe","(\d+)"/);
-        if (match) {
-          const pid = parseInt(match[1]);
-          processes.push({
-            pid,
-            startTime: new Date(), // Approximate start time for fallback
-          });
-          console.log(`🔄 ✅ Added ElementClient.exe PID ${pid} via fallback`);
-        }
-      }
-
-      console.log(`🔄 Final fallback process count: ${processes.length}`);
-      return processes;
-    } catch (error) {
-      console.error('🔄 Tasklist fallback failed:', error);
-      return [];
-    }
+    return processes;
   }
 
   private async checkIfProcessExists(pid: number): Promise<boolean> {
@@ -409,36 +227,15 @@ export class GameProcessManager extends EventEmitter {
     }
 
     try {
-      // Check if the specific PID exists and verify it's ElementClient.exe
-      const { stdout } = await execAsync(`tasklist /fi "pid eq ${pid}" /fo csv /nh`, {
-        timeout: 3000,
-      });
-
-      // More robust parsing - tasklist CSV format: "Image Name","PID","Session Name","Session#","Mem Usage"
-      if (!stdout || !stdout.trim()) {
-        console.log(`checkIfProcessExists: No output for PID ${pid}`);
-        return false;
-      }
-
-      // Split by lines and look for our PID
-      const lines = stdout.split('\n').filter((line) => line.trim());
-      for (const line of lines) {
-        // Parse CSV line properly - look for our PID in the second column
-        const csvMatch = line.match(/"([^"]+)","(\d+)","([^"]*)","([^"]*)","([^"]*)"/);
-        if (csvMatch) {
-          const [, imageName, pidStr] = csvMatch;
-          if (parseInt(pidStr) === pid) {
-            const isElementClient = imageName.toLowerCase() === 'elementclient.exe';
-            console.log(
-              `checkIfProcessExists: PID ${pid} found as "${imageName}", isElementClient: ${isElementClient}`
-            );
-            return isElementClient;
-          }
-        }
-      }
-
-      console.log(`checkIfProcessExists: PID ${pid} not found in tasklist output`);
-      return false;
+      // The snapshot only contains ElementClient.exe, so presence also verifies the image name
+      const liveness = await processSnapshot.checkLiveness([pid]);
+      const exists = liveness.get(pid) === true;
+      logger.debug(
+        () => `checkIfProcessExists: PID ${pid} ${exists ? 'found' : 'not found'} in snapshot`,
+        null,
+        'PROCESS_MANAGER'
+      );
+      return exists;
     } catch (error) {
       console.warn(`checkIfProcessExists: Error checking PID ${pid}:`, error);
       return false;
@@ -461,117 +258,34 @@ export class GameProcessManager extends EventEmitter {
 
       console.log(`Checking ${this.processes.size} tracked processes for crashes...`);
 
+      // One snapshot answers every tracked PID instead of a query per account
+      const trackedPids = Array.from(this.processes.values())
+        .map((p) => p.pid)
+        .filter((pid) => pid > 0);
+      let liveness: Map<number, boolean> | null = null;
+      try {
+        liveness = await processSnapshot.checkLiveness(trackedPids);
+      } catch (error) {
+        console.warn('Error checking tracked process liveness:', error);
+      }
+
       for (const [accountId, processInfo] of this.processes.entries()) {
         let stillRunning = false;
 
         if (processInfo.pid === -1 || processInfo.pid === -2) {
-          // For processes without PID or in launching state
-          if (processInfo.pid === -2) {
-            // Still launching - only try to find PID if it's been a reasonable time
-            const processAge = Date.now() - (processInfo as any).launchTime || 0;
-            if (processAge > 10000) {
-              // Only try after 10 seconds
-              try {
-                const currentProcesses = await this.getElementClientProcesses();
-                const assignedPids = new Set(
-                  Array.from(this.processes.values())
-                    .map((p) => p.pid)
-                    .filter((p) => p > 0)
-                );
-
-                // Look for unassigned processes (remove the 30-second age restriction)
-                const unassignedProcesses = currentProcesses.filter((proc) => {
-                  return !assignedPids.has(proc.pid);
-                });
-
-                if (unassignedProcesses.length > 0) {
-                  const targetProcess = unassignedProcesses[0];
-                  processInfo.pid = targetProcess.pid;
-                  console.log(
-                    `🔄 Late association: ${processInfo.login} now has PID ${targetProcess.pid}`
-                  );
-
-                  // IMPORTANT: Send status update to UI when PID is finally detected
-                  this.emit('status-update', accountId, true);
-                  stillRunning = true;
-                } else {
-                  // Still launching or failed launch, assume still running for now
-                  stillRunning = true;
-                }
-              } catch (error) {
-                console.warn(
-                  `Could not check ElementClient processes for late association:`,
-                  error
-                );
-                stillRunning = true; // Assume still running if we can't check
-              }
-            } else {
-              stillRunning = true; // Too early to check
-            }
-          } else {
-            // PID is -1 (unknown) - when monitoring is disabled, always assume running
-            // When monitoring is enabled, we still assume running since we can't verify
-            stillRunning = true;
-          }
+          // Launching entries are resolved by trackSpawnedProcess; unknown PIDs cannot be
+          // verified, so both are assumed to be running
+          stillRunning = true;
         } else {
-          // For processes with PID, check specifically if still exists
-          try {
-            stillRunning = await this.checkIfProcessExists(processInfo.pid);
-            console.log(
-              `Process check for ${processInfo.login} (PID ${processInfo.pid}): ${stillRunning ? 'RUNNING' : 'NOT FOUND'}`
-            );
-          } catch (error) {
-            console.warn(
-              `Error checking process existence for ${processInfo.login} (PID ${processInfo.pid}):`,
-              error
-            );
-            stillRunning = true; // Assume still running if check fails
-          }
-        }
-
-        if (!stillRunning) {
+          // Assume still running if the batched check failed
+          stillRunning = liveness ? liveness.get(processInfo.pid) === true : true;
           console.log(
-            `Process ${processInfo.pid === -1 ? '(unknown PID)' : processInfo.pid} for account ${processInfo.login} crashed or was closed`
+            `Process check for ${processInfo.login} (PID ${processInfo.pid}): ${stillRunning ? 'RUNNING' : 'NOT FOUND'}`
           );
+        }
 
-          // Check if this was a user-initiated closure or a crash
-          const wasUserInitiated = this.userInitiatedClosures.has(accountId);
-          const launchData = this.accountLaunchData.get(accountId);
-
-          if (!wasUserInitiated && launchData && this.shouldAutoRestart()) {
-            console.log(`💥 Crash detected for ${processInfo.login} - attempting auto-restart...`);
-
-            // Remove from current tracking
-            this.processes.delete(accountId);
-            this.emit('status-update', accountId, false);
-
-            // Attempt restart after a short delay
-            setTimeout(async () => {
-              try {
-                console.log(`🔄 Auto-restarting ${launchData.account.login}...`);
-                await this.launchGame(launchData.account, launchData.gamePath);
-                console.log(`✅ Auto-restart successful for ${launchData.account.login}`);
-              } catch (error) {
-                console.error(`❌ Auto-restart failed for ${launchData.account.login}:`, error);
-                // If restart fails, clean up launch data
-                this.accountLaunchData.delete(accountId);
-              }
-            }, 3000); // 3-second delay before restart
-          } else {
-            // Either user-initiated or auto-restart disabled/not available
-            if (wasUserInitiated) {
-              console.log(`👤 User-initiated closure for ${processInfo.login} - no auto-restart`);
-            } else {
-              console.log(`🔇 Auto-restart disabled or no launch data for ${processInfo.login}`);
-            }
-
-            this.processes.delete(accountId);
-            this.emit('status-update', accountId, false);
-
-            // Clean up launch data and user closure flag
-            this.accountLaunchData.delete(accountId);
-            this.userInitiatedClosures.delete(accountId);
-          }
+        if (!stillRunning) {
+          this.handleProcessGone(accountId, processInfo);
         }
       }
 
@@ -584,112 +298,70 @@ export class GameProcessManager extends EventEmitter {
     }
   }
 
+  // Shared by exit events and the reconciliation sweep: decide between crash restart and cleanup
+  private handleProcessGone(accountId: string, processInfo: ProcessInfo): void {
+    console.log(
+      `Process ${processInfo.pid === -1 ? '(unknown PID)' : processInfo.pid} for account ${processInfo.login} crashed or was closed`
+    );
+
+    // Check if this was a user-initiated closure or a crash
+    const wasUserInitiated = this.userInitiatedClosures.has(accountId);
+    const launchData = this.accountLaunchData.get(accountId);
+
+    if (!wasUserInitiated && launchData && this.shouldAutoRestart()) {
+      console.log(`💥 Crash detected for ${processInfo.login} - attempting auto-restart...`);
+
+      // Remove from current tracking
+      this.processes.delete(accountId);
+      this.emit('status-update', accountId, false);
+
+      // Attempt restart after a short delay
+      setTimeout(async () => {
+        try {
+          console.log(`🔄 Auto-restarting ${launchData.account.login}...`);
+          await this.launchGame(launchData.account, launchData.gamePath);
+          console.log(`✅ Auto-restart successful for ${launchData.account.login}`);
+        } catch (error) {
+          console.error(`❌ Auto-restart failed for ${launchData.account.login}:`, error);
+          // If restart fails, clean up launch data
+          this.accountLaunchData.delete(accountId);
+        }
+      }, 3000); // 3-second delay before restart
+    } else {
+      // Either user-initiated or auto-restart disabled/not available
+      if (wasUserInitiated) {
+        console.log(`👤 User-initiated closure for ${processInfo.login} - no auto-restart`);
+      } else {
+        console.log(`🔇 Auto-restart disabled or no launch data for ${processInfo.login}`);
+      }
+
+      this.processes.delete(accountId);
+      this.emit('status-update', accountId, false);
+
+      // Clean up launch data and user closure flag
+      this.accountLaunchData.delete(accountId);
+      this.userInitiatedClosures.delete(accountId);
+    }
+  }
+
   async launchGame(account: Account, gamePath: string): Promise<void> {
     logger.startOperation(`Launching ${account.login}`);
 
     return new Promise((resolve, reject) => {
       (async () => {
         try {
-          // Get ALL existing ElementClient.exe processes before launch
-          const existingProcesses = await this.getElementClientProcesses();
-          logger.info(
-            `Pre-launch: Found ${existingProcesses.length} existing ElementClient.exe processes`,
-            {
-              count: existingProcesses.length,
-              pids: existingProcesses.map((p) => p.pid),
-            },
-            'LAUNCH'
-          );
-
           // Record launch time for reliable new process detection
           const launchTime = new Date();
+          const endSpawnSpan = metrics.startSpan('launch.spawn', { account: account.login });
 
-          // Build command arguments for direct game launch
-          logger.info(
-            `Game path received: "${gamePath}"`,
-            {
-              gamePath,
-              pathLength: gamePath.length,
-              pathChars: [...gamePath].map((c) => c.charCodeAt(0)),
-            },
-            'LAUNCH'
+          // Executable location and command line are cached per account until they change
+          const planHits = this.launchPlans.hits;
+          const { gameDir, exeName, fullExePath, args } = await this.launchPlans.get(
+            account,
+            gamePath
           );
-
-          let gameDir: string;
-          let exeName: string;
-
-          // Handle different gamePath formats
-          if (gamePath.toLowerCase().endsWith('.exe')) {
-            // If gamePath includes .exe, use it as-is
-            gameDir = path.dirname(gamePath);
-            exeName = path.basename(gamePath);
-          } else {
-            // If gamePath is a directory, look for ElementClient.exe in it
-            gameDir = gamePath;
-            exeName = 'ElementClient.exe';
-          }
-
-          logger.info(
-            `Parsed game directory: "${gameDir}", executable: "${exeName}"`,
-            {
-              gameDir,
-              originalPath: gamePath,
-              exeName,
-            },
-            'LAUNCH'
-          );
-
-          const args = [
-            'startbypatcher',
-            'nocheck',
-            `user:${account.login}`,
-            `pwd:${account.password}`,
-          ];
-
-          // Add character name if present
-          if (account.characterName && account.characterName.trim()) {
-            args.push(`role:${account.characterName}`);
-          }
-
-          args.push('rendernofocus');
-
-          // Check if executable exists
-          let fullExePath = path.join(gameDir, exeName);
-          logger.info(`Checking for executable at: ${fullExePath}`, { fullExePath }, 'LAUNCH');
-
-          try {
-            await fs.promises.access(fullExePath);
-            logger.info(`Executable found, proceeding with launch`, null, 'LAUNCH');
-          } catch (accessError) {
-            // If not found in the direct path, check common subdirectories
-            logger.warn(`Executable not found at primary path: ${fullExePath}`, null, 'LAUNCH');
-
-            // Try alternative paths
-            const alternativePaths = [
-              path.join(gameDir, 'element', 'ElementClient.exe'), // Check element subdirectory
-              path.join(gameDir, '..', 'ElementClient.exe'), // Check parent directory
-            ];
-
-            let found = false;
-            for (const altPath of alternativePaths) {
-              try {
-                await fs.promises.access(altPath);
-                logger.info(`Found executable at alternative path: ${altPath}`, null, 'LAUNCH');
-                fullExePath = altPath;
-                gameDir = path.dirname(altPath); // Update gameDir to the correct location
-                found = true;
-                break;
-              } catch {
-                // Continue searching
-              }
-            }
-
-            if (!found) {
-              throw new Error(
-                `Game executable not found!\n\nSearched locations:\n- ${fullExePath}\n- ${alternativePaths.join('\n- ')}\n\nPlease update your game path setting to point to:\n- The folder containing ElementClient.exe\n- Or the full path to ElementClient.exe\n\nCurrent setting: ${gamePath}`
-              );
-            }
-          }
+          const planCached = this.launchPlans.hits > planHits;
+          metrics.increment(planCached ? 'launchPlan.hit' : 'launchPlan.miss');
 
           logger.info(
             `Launching game directly: ${exeName} ${args.join(' ')}`,
@@ -709,7 +381,13 @@ export class GameProcessManager extends EventEmitter {
             stdio: 'ignore',
           });
 
+          if (!child.pid) {
+            this.launchPlans.invalidate(account.id);
+            throw new Error(`Failed to start ${fullExePath}`);
+          }
+
           child.unref();
+          endSpawnSpan({ pid: child.pid });
 
           // Store launch data for potential auto-restart
           this.accountLaunchData.set(account.id, { account, gamePath });
@@ -723,14 +401,15 @@ export class GameProcessManager extends EventEmitter {
             pid: -2, // Special marker for "launching" state
             login: account.login,
             windowTitle: '',
+            rootPid: child.pid,
             launchTime: launchTime, // Track when this was launched
           } as any);
 
           // Set initial status to running (will be updated when we find the actual process)
           this.emit('status-update', account.id, true);
 
-          // Wait and find the new ElementClient.exe process - resolve when PID is found
-          this.findNewElementClientProcess(account, existingProcesses, launchTime, resolve, reject);
+          // Follow the spawned process tree - resolves as soon as the client shows up in a snapshot
+          this.trackSpawnedProcess(account, child, launchTime, resolve, reject);
         } catch (error) {
           logger.error(`Failed to launch game for ${account.login}`, error, 'LAUNCH');
           logger.endOperation(false);
@@ -740,149 +419,143 @@ export class GameProcessManager extends EventEmitter {
     });
   }
 
-  private async findNewElementClientProcess(
+  private trackSpawnedProcess(
     account: Account,
-    existingProcesses: Array<{ pid: number; startTime: Date }>,
+    child: ChildProcess,
     launchTime: Date,
     resolve: () => void,
-    _reject: (error: any) => void
-  ): Promise<void> {
-    const maxAttempts = 10; // Increased from 5 to 10
-    let attempts = 0;
-
-    // Create set of existing PIDs to exclude
-    const existingPids = new Set(existingProcesses.map((p) => p.pid));
-
-    const findProcess = async (): Promise<void> => {
-      attempts++;
-
-      try {
-        console.log(
-          `🔍 Attempt ${attempts}/${maxAttempts} for ${account.login} (launched at ${launchTime.toLocaleTimeString()})`
-        );
+    reject: (error: any) => void
+  ): void {
+    const rootPid = child.pid as number;
+    let settled = false;
+    let pollTimer: NodeJS.Timeout | null = null;
+
+    const cleanup = () => {
+      settled = true;
+      clearTimeout(timeoutTimer);
+      if (pollTimer) {
+        clearTimeout(pollTimer);
+      }
+      processSnapshot.off('process-start', onProcessStart);
+    };
 
-        // Get current processes with start times - use WMI only when needed
-        const currentProcesses = await this.getElementClientProcesses();
+    const associate = (pid: number) => {
+      cleanup();
 
-        // Find processes that started after our launch time and aren't in existing PIDs
-        const candidateProcesses = currentProcesses.filter((proc) => {
-          const isNew = !existingPids.has(proc.pid);
-          const timeDiff = proc.startTime.getTime() - launchTime.getTime();
-          const startedAfterLaunch = timeDiff >= -2000; // Allow 2 second tolerance for time differences
+      const current = this.processes.get(account.id);
+      if (!current) {
+        // Closed by the user while still launching
+        logger.endOperation(true);
+        resolve();
+        return;
+      }
 
-          console.log(
-            `  📊 PID ${proc.pid}: new=${isNew}, startedAfter=${startedAfterLaunch} (started: ${proc.startTime.toLocaleTimeString()}, diff: ${timeDiff}ms)`
-          );
+      current.pid = pid;
+      metrics.record('launch.pidAssociation', Date.now() - launchTime.getTime(), {
+        account: account.login,
+        pid,
+      });
+      logger.info(
+        `Associated process ${pid} with account ${account.login}`,
+        { pid, rootPid, accountId: account.id, elapsedMs: Date.now() - launchTime.getTime() },
+        'LAUNCH'
+      );
 
-          return isNew && startedAfterLaunch;
-        });
+      // Send status update to refresh UI with actual PID
+      this.emit('status-update', account.id, true);
+      this.startOptionalCrashDetection();
 
-        // Filter out PIDs already assigned to other accounts in our tracking
-        const assignedPids = new Set(
-          Array.from(this.processes.values())
-            .map((p) => p.pid)
-            .filter((p) => p > 0)
-        );
+      logger.endOperation(true);
+      resolve();
+    };
 
-        const availableProcesses = candidateProcesses.filter((proc) => !assignedPids.has(proc.pid));
+    const tryAssociate = (): boolean => {
+      if (settled) {
+        return true;
+      }
 
-        console.log(
-          `  🆕 Candidate processes: [${candidateProcesses.map((p) => p.pid).join(', ')}]`
-        );
-        console.log(`  🏷️ Already assigned PIDs: [${Array.from(assignedPids).join(', ')}]`);
-        console.log(
-          `  ✅ Available processes: [${availableProcesses.map((p) => p.pid).join(', ')}]`
-        );
+      const target = selectTreeLeaf(processSnapshot.findProcessTree(rootPid, launchTime));
+      if (target) {
+        associate(target.pid);
+        return true;
+      }
+      return false;
+    };
 
-        if (availableProcesses.length > 0) {
-          // Take the process that started closest to our launch time
-          const targetProcess = availableProcesses.reduce((closest, current) => {
-            const closestDiff = Math.abs(closest.startTime.getTime() - launchTime.getTime());
-            const currentDiff = Math.abs(current.startTime.getTime() - launchTime.getTime());
-            return currentDiff < closestDiff ? current : closest;
-          });
+    const onProcessStart = () => {
+      tryAssociate();
+    };
 
-          // Update the existing entry with the real PID
-          this.processes.set(account.id, {
-            accountId: account.id,
-            pid: targetProcess.pid,
-            login: account.login,
-            windowTitle: '',
-          });
+    const poll = async () => {
+      pollTimer = null;
+      try {
+        await processSnapshot.refresh();
+      } catch (error) {
+        console.warn(`Snapshot refresh failed while tracking ${account.login}:`, error);
+      }
 
-          logger.info(
-            `Successfully associated process ${targetProcess.pid} with account ${account.login}`,
-            {
-              pid: targetProcess.pid,
-              accountId: account.id,
-              startTime: targetProcess.startTime,
-            },
-            'LAUNCH'
-          );
+      if (!tryAssociate()) {
+        pollTimer = setTimeout(poll, this.ASSOCIATION_POLL_INTERVAL);
+      }
+    };
 
-          // Send status update to refresh UI with actual PID
-          this.emit('status-update', account.id, true);
+    // Nothing appeared in the tree - keep the client as running with an unknown PID
+    const timeoutTimer = setTimeout(() => {
+      if (settled) {
+        return;
+      }
+      cleanup();
 
-          // Start crash detection now that we have a process to monitor
-          this.startOptionalCrashDetection();
+      console.warn(
+        `⚠️ ElementClient.exe for ${account.login} (spawned PID ${rootPid}) not visible after ${this.ASSOCIATION_TIMEOUT}ms`
+      );
 
-          // Resolve the Promise - PID found successfully
-          logger.endOperation(true);
-          resolve();
-          return;
-        }
+      const current = this.processes.get(account.id);
+      if (current) {
+        current.pid = -1; // Special marker for "unknown PID"
+        this.emit('status-update', account.id, true);
+        this.startOptionalCrashDetection();
+      }
 
-        // If no new process found and we haven't reached max attempts, try again
-        if (attempts < maxAttempts) {
-          setTimeout(findProcess, 3000); // 3 second delay between attempts
-        } else {
-          console.warn(
-            `⚠️ Could not find ElementClient.exe process for account ${account.login} after ${maxAttempts} attempts`
-          );
-          console.warn(`⚠️ The process may have started but couldn't be reliably associated`);
+      logger.endOperation(true);
+      resolve();
+    }, this.ASSOCIATION_TIMEOUT);
 
-          // Mark as unknown PID but still running
-          this.processes.set(account.id, {
-            accountId: account.id,
-            pid: -1, // Special marker for "unknown PID"
-            login: account.login,
-            windowTitle: '',
-          });
+    // The spawned process ending before its tree was seen means the client never came up
+    child.once('exit', async (code) => {
+      if (settled) {
+        return;
+      }
 
-          console.log(
-            `Created fallback process entry for ${account.login} (PID unknown - but likely running)`
-          );
-          this.emit('status-update', account.id, true);
-          this.startOptionalCrashDetection();
+      try {
+        await processSnapshot.refresh();
+      } catch {
+        // Fall through to the failure path
+      }
+      if (tryAssociate()) {
+        return;
+      }
 
-          // Resolve - launch is considered complete even with unknown PID
-          logger.endOperation(true);
-          resolve();
-        }
-      } catch (error) {
-        console.error('Error finding new ElementClient process:', error);
-        if (attempts < maxAttempts) {
-          setTimeout(findProcess, 3000);
-        } else {
-          // Create fallback entry even on error
-          this.processes.set(account.id, {
-            accountId: account.id,
-            pid: -1,
-            login: account.login,
-            windowTitle: '',
-          });
-          this.emit('status-update', account.id, true);
-          this.startOptionalCrashDetection();
+      cleanup();
+      logger.error(
+        `Client for ${account.login} exited during startup`,
+        { rootPid, code },
+        'LAUNCH'
+      );
 
-          // Resolve even with fallback - launch is complete
-          logger.endOperation(true);
-          resolve();
-        }
+      if (this.processes.get(account.id)?.pid === -2) {
+        this.processes.delete(account.id);
+        this.accountLaunchData.delete(account.id);
+        this.emit('status-update', account.id, false);
       }
-    };
 
-    // Start looking for the process after a longer delay to allow ElementClient.exe to fully start
-    setTimeout(findProcess, 5000); // Increased from 2000 to 5000ms
+      logger.endOperation(false);
+      reject(new Error(`Game client for ${account.login} exited during startup (code ${code})`));
+    });
+
+    processSnapshot.on('process-start', onProcessStart);
+    processSnapshot.startWatching();
+    poll();
   }
 
   async closeGame(accountId: string): Promise<void> {
@@ -917,67 +590,30 @@ export class GameProcessManager extends EventEmitter {
 
     try {
       if (processInfo.pid === -1 || processInfo.pid === -2) {
-        // Try to find the process by launch time and available PIDs
+        // No client PID yet - terminate the tree we spawned instead of guessing a process
         console.warn(
-          `⚠️ PID for ${processInfo.login} is ${processInfo.pid === -2 ? 'still launching' : 'unknown'} - attempting to locate process...`
+          `⚠️ PID for ${processInfo.login} is ${processInfo.pid === -2 ? 'still launching' : 'unknown'} - closing spawned process tree`
         );
 
-        try {
-          const currentProcesses = await this.getElementClientProcesses();
-          const assignedPids = new Set(
-            Array.from(this.processes.values())
-              .map((p) => p.pid)
-              .filter((p) => p > 0)
-          );
-
-          // Look for unassigned processes that might belong to this account
-          const unassignedProcesses = currentProcesses.filter(
-            (proc) => !assignedPids.has(proc.pid)
-          );
-
-          if (unassignedProcesses.length > 0) {
-            // Take the most recent unassigned process (likely belongs to this account)
-            const targetProcess = unassignedProcesses.reduce((latest, current) =>
-              current.startTime > latest.startTime ? current : latest
-            );
-
-            console.log(
-              `🎯 Found potential process PID ${targetProcess.pid} for ${processInfo.login}, attempting to close...`
-            );
+        if (processInfo.rootPid && process.platform === 'win32') {
+          try {
+            const { stdout } = await execAsync(`taskkill /PID ${processInfo.rootPid} /T /F`);
+            console.log(`💀 Taskkill output for tree ${processInfo.rootPid}: "${stdout.trim()}"`);
             logger.info(
-              `Attempting to close unassigned process`,
-              {
-                accountId,
-                foundPid: targetProcess.pid,
-                processStartTime: targetProcess.startTime,
-              },
+              `Closed spawned process tree`,
+              { accountId, rootPid: processInfo.rootPid },
+              'CLOSE'
+            );
+          } catch (killError) {
+            // Tree already gone
+            logger.warn(
+              `Could not close spawned process tree`,
+              { accountId, rootPid: processInfo.rootPid, error: killError },
               'CLOSE'
             );
-
-            // Try to kill this process
-            if (process.platform === 'win32') {
-              const { stdout, stderr } = await execAsync(`taskkill /PID ${targetProcess.pid} /F`);
-              console.log(`💀 Taskkill output for ${targetProcess.pid}: "${stdout.trim()}"`);
-              if (stderr) {
-                console.error(`💀 Taskkill error: "${stderr.trim()}"`);
-              } else {
-                console.log(
-                  `✅ Successfully closed process ${targetProcess.pid} for ${processInfo.login}`
-                );
-                logger.info(
-                  `Successfully closed unassigned process`,
-                  { pid: targetProcess.pid },
-                  'CLOSE'
-                );
-              }
-            }
-          } else {
-            console.warn(`❌ No unassigned ElementClient processes found for ${processInfo.login}`);
-            logger.warn(`No unassigned processes found to close`, { accountId }, 'CLOSE');
           }
-        } catch (searchError) {
-          console.error(`❌ Error searching for process to close:`, searchError);
-          logger.error(`Failed to search for process to close`, searchError, 'CLOSE');
+        } else {
+          logger.warn(`No spawned PID recorded to close`, { accountId }, 'CLOSE');
         }
 
         // Always clean up tracking regardless of whether we found/killed the process
@@ -1002,16 +638,10 @@ export class GameProcessManager extends EventEmitter {
           // First verify the PID still exists and belongs to ElementClient.exe
           try {
             console.log(`🔍 Verifying PID ${processInfo.pid} for ${processInfo.login}...`);
-            const { stdout: verifyOutput } = await execAsync(
-              `tasklist /fi "pid eq ${processInfo.pid}" /fo csv /nh`
-            );
-            console.log(`🔍 Tasklist verification output: "${verifyOutput.trim()}"`);
+            const isElementClient = await this.checkIfProcessExists(processInfo.pid);
 
             // Check if it's specifically ElementClient.exe
-            if (
-              !verifyOutput.toLowerCase().includes('elementclient.exe') ||
-              !verifyOutput.includes(`"${processInfo.pid}"`)
-            ) {
+            if (!isElementClient) {
               console.log(
                 `❌ Process ${processInfo.pid} is not ElementClient.exe or already closed`
               );
@@ -1020,7 +650,6 @@ export class GameProcessManager extends EventEmitter {
                 {
                   accountId,
                   pid: processInfo.pid,
-                  verifyOutput: verifyOutput.trim(),
                 },
                 'CLOSE'
               );
@@ -1097,51 +726,123 @@ export class GameProcessManager extends EventEmitter {
     }
   }
 
-  async closeMultipleGames(accountIds: string[]): Promise<void> {
+  // Returns how many clients could not be closed
+  async closeMultipleGames(accountIds: string[]): Promise<number> {
     console.log(`🔄 closeMultipleGames called with accountIds: [${accountIds.join(', ')}]`);
     logger.startOperation(`Closing ${accountIds.length} selected accounts`);
 
+    const targets: ProcessInfo[] = [];
     for (const accountId of accountIds) {
       const processInfo = this.processes.get(accountId);
       if (processInfo) {
-        console.log(
-          `  📋 Account ${processInfo.login} (ID: ${accountId}) has PID: ${processInfo.pid}`
-        );
+        targets.push(processInfo);
       } else {
         console.log(`  ⚠️ No process info found for account ID: ${accountId}`);
       }
     }
 
-    const closePromises = accountIds.map((accountId) => this.closeGame(accountId));
-    const results = await Promise.allSettled(closePromises);
+    if (targets.length === 0) {
+      logger.endOperation(true);
+      return 0;
+    }
 
-    // Count successes and failures
-    let successCount = 0;
-    let failureCount = 0;
+    // Untrack first so exit events for these PIDs don't trigger per-account crash handling
+    for (const target of targets) {
+      this.userInitiatedClosures.add(target.accountId);
+      this.processes.delete(target.accountId);
+      this.accountLaunchData.delete(target.accountId);
+    }
 
-    // Log results for debugging
-    results.forEach((result, index) => {
-      const accountId = accountIds[index];
-      if (result.status === 'rejected') {
-        console.error(`❌ Failed to close account ${accountId}:`, result.reason);
-        failureCount++;
-      } else {
-        console.log(`✅ Successfully processed close for account ${accountId}`);
-        successCount++;
+    const knownPids = targets.map((t) => t.pid).filter((pid) => pid > 0);
+    const treeRoots = targets
+      .filter((t) => t.pid <= 0 && t.rootPid)
+      .map((t) => t.rootPid as number);
+
+    let failureCount = 0;
+    try {
+      // One snapshot tells which known PIDs still need killing
+      const liveness = await processSnapshot.checkLiveness(knownPids);
+      const alivePids = knownPids.filter((pid) => liveness.get(pid));
+
+      failureCount += await this.killPids(alivePids, false);
+      failureCount += await this.killPids(treeRoots, true);
+
+      // Confirm with one fresh snapshot instead of a check per account; a killed PID is
+      // simply absent from it
+      if (process.platform === 'win32' && alivePids.length > 0) {
+        const stillRunning = new Set((await processSnapshot.refresh()).map((proc) => proc.pid));
+        const survivors = alivePids.filter((pid) => stillRunning.has(pid));
+        if (survivors.length > 0) {
+          logger.warn(`Processes still running after taskkill`, { survivors }, 'CLOSE');
+          failureCount += survivors.length;
+        }
       }
-    });
+    } catch (error) {
+      logger.error(`Bulk close failed`, error, 'CLOSE');
+      failureCount++;
+    }
+
+    if (this.processes.size === 0) {
+      this.stopCrashDetection();
+    }
+
+    // One aggregated update for the UI instead of one event per account
+    this.emit(
+      'status-update-batch',
+      targets.map((t) => ({ accountId: t.accountId, running: false }))
+    );
 
     logger.info(
       `Multiple close operation completed`,
       {
         total: accountIds.length,
-        successful: successCount,
+        closed: targets.length,
+        pids: knownPids,
+        treeRoots,
         failed: failureCount,
       },
       'CLOSE'
     );
 
     logger.endOperation(failureCount === 0);
+    return failureCount;
+  }
+
+  // Kills PIDs with as few taskkill invocations as the command line allows; returns failures
+  private async killPids(pids: number[], includeTree: boolean): Promise<number> {
+    if (pids.length === 0) {
+      return 0;
+    }
+
+    if (process.platform !== 'win32') {
+      let failures = 0;
+      for (const pid of pids) {
+        try {
+          process.kill(pid, 'SIGTERM');
+        } catch (killError) {
+          console.warn(`Could not kill PID ${pid}:`, killError);
+          failures++;
+        }
+      }
+      return failures;
+    }
+
+    let failures = 0;
+    for (let i = 0; i < pids.length; i += this.TASKKILL_BATCH_SIZE) {
+      const batch = pids.slice(i, i + this.TASKKILL_BATCH_SIZE);
+      const pidArgs = batch.map((pid) => `/PID ${pid}`).join(' ');
+      try {
+        const { stdout } = await execAsync(`taskkill ${pidArgs}${includeTree ? ' /T' : ''} /F`);
+        console.log(`💀 Taskkill output: "${stdout.trim()}"`);
+      } catch (error: any) {
+        // taskkill exits non-zero if any PID failed; the others in the batch were still killed
+        const output = String(error?.stdout || '') + String(error?.stderr || '');
+        const failed = (output.match(/ERROR:/g) || []).length;
+        failures += failed;
+        logger.warn(`Taskkill reported failures`, { pids: batch, output: output.trim() }, 'CLOSE');
+      }
+    }
+    return failures;
   }
 
   async closeAllGames(): Promise<void> {
@@ -1153,6 +854,10 @@ export class GameProcessManager extends EventEmitter {
     return Array.from(this.processes.values());
   }
 
+  getProcessInfo(accountId: string): ProcessInfo | undefined {
+    return this.processes.get(accountId);
+  }
+
   isAccountRunning(accountId: string): boolean {
     return this.processes.has(accountId);
   }
@@ -1167,13 +872,16 @@ export class GameProcessManager extends EventEmitter {
       this.startOptionalCrashDetection();
     }
 
-    const mode = this.settingsManager?.getSettings()?.processMonitoringMode || '3min';
+    const mode = this.settingsManager?.getCachedSettings().processMonitoringMode || '3min';
     console.log(
       `Process monitoring updated to: ${mode} (${this.LIGHTWEIGHT_CHECK_INTERVAL}ms interval)`
     );
   }
 
   destroy(): void {
+    this.unsubscribeSettings?.();
+    this.unsubscribeSettings = null;
+
     if (this.processCheckInterval) {
       clearInterval(this.processCheckInterval);
       this.processCheckInterval = null;
@@ -1182,14 +890,13 @@ export class GameProcessManager extends EventEmitter {
     // Clear all tracked processes
     this.processes.clear();
 
-    // Clear process cache to free memory
-    this.processCache.clear();
-
     // Clear auto-restart data
     this.accountLaunchData.clear();
     this.userInitiatedClosures.clear();
 
     // Remove all event listeners to prevent memory leaks
+    processSnapshot.off('process-exit', this.handleProcessExitEvent);
+    processSnapshot.off('host-lost', this.handleSnapshotHostLost);
     this.removeAllListeners();
   }
 }
@@ -0,0 +1,154 @@
+import * as path from 'path';
+import * as fs from 'fs/promises';
+import { createHash } from 'crypto';
+import { Account } from '../../shared/types';
+import { buildLaunchArguments } from './batchFileFormat';
+import { logger } from './loggingService';
+
+export interface LaunchPlan {
+  key: string; // Hash of everything the plan was built from
+  gameDir: string; // Working directory for the client
+  exeName: string;
+  fullExePath: string;
+  args: string[];
+}
+
+interface ResolvedExecutable {
+  gameDir: string;
+  exeName: string;
+  fullExePath: string;
+}
+
+// Everything launchGame works out before spawning - where the executable really is and the
+// command line - kept per account. A plan is rebuilt when its hash of login, password,
+// character and game path no longer matches, or after a spawn from it failed.
+export class LaunchPlanCache {
+  private plans: Map<string, LaunchPlan> = new Map();
+  private executables: Map<string, ResolvedExecutable> = new Map(); // By configured game path
+  hits = 0;
+  misses = 0;
+
+  async get(account: Account, gamePath: string): Promise<LaunchPlan> {
+    const key = planKey(account, gamePath);
+    const cached = this.plans.get(account.id);
+    if (cached && cached.key === key) {
+      this.hits++;
+      return cached;
+    }
+
+    this.misses++;
+    const plan: LaunchPlan = {
+      key,
+      ...(await this.resolveExecutable(gamePath)),
+      args: buildLaunchArguments(account),
+    };
+    this.plans.set(account.id, plan);
+    return plan;
+  }
+
+  // Drops one account's plan, or everything (e.g. the game path setting changed)
+  invalidate(accountId?: string): void {
+    if (accountId === undefined) {
+      this.plans.clear();
+      this.executables.clear();
+      return;
+    }
+
+    const plan = this.plans.get(accountId);
+    this.plans.delete(accountId);
+    if (plan) {
+      // The executable may have moved; look it up again next time
+      for (const [gamePath, resolved] of this.executables) {
+        if (resolved.fullExePath === plan.fullExePath) {
+          this.executables.delete(gamePath);
+        }
+      }
+    }
+  }
+
+  get size(): number {
+    return this.plans.size;
+  }
+
+  private async resolveExecutable(gamePath: string): Promise<ResolvedExecutable> {
+    const cached = this.executables.get(gamePath);
+    if (cached) {
+      return cached;
+    }
+
+    logger.info(
+      `Game path received: "${gamePath}"`,
+      {
+        gamePath,
+        pathLength: gamePath.length,
+        pathChars: [...gamePath].map((c) => c.charCodeAt(0)),
+      },
+      'LAUNCH'
+    );
+
+    let gameDir: string;
+    let exeName: string;
+
+    // Handle different gamePath formats
+    if (gamePath.toLowerCase().endsWith('.exe')) {
+      // If gamePath includes .exe, use it as-is
+      gameDir = path.dirname(gamePath);
+      exeName = path.basename(gamePath);
+    } else {
+      // If gamePath is a directory, look for ElementClient.exe in it
+      gameDir = gamePath;
+      exeName = 'ElementClient.exe';
+    }
+
+    // Check if executable exists
+    let fullExePath = path.join(gameDir, exeName);
+    logger.info(`Checking for executable at: ${fullExePath}`, { fullExePath }, 'LAUNCH');
+
+    try {
+      await fs.access(fullExePath);
+      logger.info(`Executable found, proceeding with launch`, null, 'LAUNCH');
+    } catch (accessError) {
+      // If not found in the direct path, check common subdirectories
+      logger.warn(`Executable not found at primary path: ${fullExePath}`, null, 'LAUNCH');
+
+      // Try alternative paths
+      const alternativePaths = [
+        path.join(gameDir, 'element', 'ElementClient.exe'), // Check element subdirectory
+        path.join(gameDir, '..', 'ElementClient.exe'), // Check parent directory
+      ];
+
+      let found = false;
+      for (const altPath of alternativePaths) {
+        try {
+          await fs.access(altPath);
+          logger.info(`Found executable at alternative path: ${altPath}`, null, 'LAUNCH');
+          fullExePath = altPath;
+          gameDir = path.dirname(altPath); // Update gameDir to the correct location
+          exeName = path.basename(altPath);
+          found = true;
+          break;
+        } catch {
+          // Continue searching
+        }
+      }
+
+      if (!found) {
+        throw new Error(
+          `Game executable not found!\n\nSearched locations:\n- ${fullExePath}\n- ${alternativePaths.join('\n- ')}\n\nPlease update your game path setting to point to:\n- The folder containing ElementClient.exe\n- Or the full path to ElementClient.exe\n\nCurrent setting: ${gamePath}`
+        );
+      }
+    }
+
+    const resolved = { gameDir, exeName, fullExePath };
+    this.executables.set(gamePath, resolved);
+    return resolved;
+  }
+}
+
+function planKey(account: Account, gamePath: string): string {
+  return createHash('sha1')
+    .update(
+      JSON.stringify([account.login, account.password, account.characterName ?? '', gamePath])
+    )
+    .digest('hex');
+}
@@ -0,0 +1,281 @@
+import { EventEmitter } from 'events';
+import { Account, JobProgress } from '../../shared/types';
+import { GameProcessManager } from './gameProcessManager';
+import { processSnapshot } from './processSnapshotService';
+import { logger } from './loggingService';
+import { ResourceMonitor } from './resourceMonitor';
+import { metrics } from './performanceMetrics';
+
+export interface LaunchOptions {
+  maxConcurrent: number; // How many clients may be starting up at the same time
+  launchDelay: number; // Upper bound in seconds to wait for a client to become ready
+  cpuLimit?: number; // System CPU % above which the next launch waits
+  memoryLimit?: number; // System memory % the job may fill, counting clients still loading
+}
+
+interface LaunchJob {
+  id: string;
+  accounts: Account[];
+  gamePath: string;
+  options: Required<LaunchOptions>;
+  queue: Account[]; // Not started yet; may be taken out of order to fit the memory budget
+  launched: number;
+  failed: number;
+  cancelled: boolean;
+  active: Set<string>;
+  starting: Map<string, number>; // Account id -> expected footprint of clients still loading
+  throttled?: 'cpu' | 'memory';
+}
+
+// Starts a group of accounts through a bounded pool of launch slots. A slot is released as
+// soon as its client is ready (PID associated, window created or CPU usage settled) instead
+// of after a fixed delay, so the next launch starts while earlier clients keep loading.
+// Before each launch the machine must have headroom: CPU under the limit and room in the
+// memory budget for the client's expected footprint. When the next account does not fit,
+// a later one with a smaller footprint may go first.
+export class LaunchScheduler extends EventEmitter {
+  private processManager: GameProcessManager;
+  private resourceMonitor: ResourceMonitor;
+  private jobs: Map<string, LaunchJob> = new Map();
+  private readonly READINESS_POLL_INTERVAL = 1000;
+  private readonly CPU_SETTLE_SECONDS = 0.3; // CPU time per poll below which loading is over
+  private readonly HEADROOM_POLL_INTERVAL = 2000;
+  private readonly MAX_THROTTLE_WAIT = 120000; // Launch anyway after this long without headroom
+
+  constructor(processManager: GameProcessManager, resourceMonitor: ResourceMonitor) {
+    super();
+    this.processManager = processManager;
+    this.resourceMonitor = resourceMonitor;
+  }
+
+  // Queues a group launch under the given job id; progress is reported via 'progress' events
+  start(jobId: string, accounts: Account[], gamePath: string, options: LaunchOptions): void {
+    const job: LaunchJob = {
+      id: jobId,
+      accounts,
+      gamePath,
+      options: {
+        maxConcurrent: Math.max(1, Math.floor(options.maxConcurrent)),
+        launchDelay: Math.max(1, options.launchDelay),
+        cpuLimit: clampPercent(options.cpuLimit, 85),
+        memoryLimit: clampPercent(options.memoryLimit, 90),
+      },
+      queue: [...accounts],
+      launched: 0,
+      failed: 0,
+      cancelled: false,
+      active: new Set(),
+      starting: new Map(),
+    };
+
+    this.jobs.set(job.id, job);
+    logger.info(
+      `Group launch ${job.id}: ${accounts.length} accounts, ${job.options.maxConcurrent} at a time`,
+      { jobId: job.id, maxConcurrent: job.options.maxConcurrent },
+      'LAUNCH'
+    );
+
+    this.run(job).catch((error) => {
+      logger.error(`Group launch ${job.id} failed`, error, 'LAUNCH');
+      this.jobs.delete(job.id);
+      this.reportProgress(job, 'completed'); // Still finish the job for anyone awaiting it
+    });
+  }
+
+  // Stops queued launches; clients already spawned keep running. Cancels all jobs without an id.
+  cancel(jobId?: string): boolean {
+    let cancelledAny = false;
+    for (const job of this.jobs.values()) {
+      if (!jobId || job.id === jobId) {
+        if (!job.cancelled) {
+          job.cancelled = true;
+          cancelledAny = true;
+          logger.info(`Group launch ${job.id} cancelled`, null, 'LAUNCH');
+        }
+      }
+    }
+    return cancelledAny;
+  }
+
+  hasActiveJobs(): boolean {
+    return this.jobs.size > 0;
+  }
+
+  private async run(job: LaunchJob): Promise<void> {
+    this.reportProgress(job, 'running');
+
+    const slotCount = Math.min(job.options.maxConcurrent, job.accounts.length);
+    const slots: Promise<void>[] = [];
+    for (let i = 0; i < slotCount; i++) {
+      slots.push(this.runSlot(job));
+    }
+    await Promise.all(slots);
+
+    this.jobs.delete(job.id);
+    this.reportProgress(job, job.cancelled ? 'cancelled' : 'completed');
+  }
+
+  private async runSlot(job: LaunchJob): Promise<void> {
+    while (!job.cancelled && job.queue.length > 0) {
+      const skipped = job.queue.findIndex((a) => this.processManager.isAccountRunning(a.id));
+      if (skipped !== -1) {
+        const [account] = job.queue.splice(skipped, 1);
+        console.log(`⏭️ Skipping ${account.login} - already running`);
+        job.launched++;
+        this.reportProgress(job, 'running');
+        continue;
+      }
+
+      const account = await this.takeNextAccount(job);
+      if (!account) {
+        break;
+      }
+
+      job.active.add(account.login);
+      job.starting.set(account.id, this.resourceMonitor.expectedFootprint(account.id));
+      this.reportProgress(job, 'running');
+
+      const endSpan = metrics.startSpan('launch.account', {
+        account: account.login,
+        jobId: job.id,
+      });
+      try {
+        const position = job.accounts.length - job.queue.length;
+        console.log(`🚀 Launching ${account.login} (${position}/${job.accounts.length})`);
+        await this.processManager.launchGame(account, job.gamePath);
+        await this.waitForReady(job, account);
+        job.launched++;
+        endSpan({ ok: true });
+      } catch (error) {
+        logger.error(`Group launch failed for ${account.login}`, error, 'LAUNCH');
+        job.failed++;
+        endSpan({ ok: false });
+      } finally {
+        job.active.delete(account.login);
+        job.starting.delete(account.id);
+      }
+
+      this.reportProgress(job, 'running');
+    }
+  }
+
+  // Waits until the machine has headroom and takes the first queued account that fits.
+  // Clients still loading count with their expected footprint, since the OS does not show
+  // their memory yet. Returns null if the job was cancelled or emptied meanwhile.
+  private async takeNextAccount(job: LaunchJob): Promise<Account | null> {
+    const waitStarted = Date.now();
+
+    while (!job.cancelled && job.queue.length > 0) {
+      const usage = await this.resourceMonitor.sampleSystem();
+      const cpuOk = usage.cpuPercent < job.options.cpuLimit;
+
+      let reserved = 0;
+      for (const bytes of job.starting.values()) {
+        reserved += bytes;
+      }
+      const usedBytes = usage.totalMemoryBytes - usage.freeMemoryBytes + reserved;
+      const budget = (usage.totalMemoryBytes * job.options.memoryLimit) / 100 - usedBytes;
+
+      const index = cpuOk
+        ? job.queue.findIndex((a) => this.resourceMonitor.expectedFootprint(a.id) <= budget)
+        : -1;
+      const waitedTooLong = Date.now() - waitStarted > this.MAX_THROTTLE_WAIT;
+
+      if (index !== -1 || waitedTooLong) {
+        if (index === -1) {
+          const waited = this.MAX_THROTTLE_WAIT / 1000;
+          logger.warn(
+            `Group launch ${job.id}: no headroom after ${waited}s, launching anyway`,
+            usage,
+            'LAUNCH'
+          );
+        } else if (index > 0) {
+          console.log(`🔀 ${job.queue[index].login} fits the memory budget first`);
+        }
+        if (job.throttled) {
+          job.throttled = undefined;
+          this.reportProgress(job, 'running');
+        }
+        return job.queue.splice(Math.max(index, 0), 1)[0];
+      }
+
+      const reason = cpuOk ? 'memory' : 'cpu';
+      if (job.throttled !== reason) {
+        job.throttled = reason;
+        logger.info(
+          `Group launch ${job.id} waiting for ${reason} headroom`,
+          { ...usage, cpuLimit: job.options.cpuLimit, memoryLimit: job.options.memoryLimit },
+          'LAUNCH'
+        );
+        this.reportProgress(job, 'running');
+      }
+      await new Promise((resolve) => setTimeout(resolve, this.HEADROOM_POLL_INTERVAL));
+    }
+
+    return null;
+  }
+
+  // Resolves once the client shows a window or stops burning CPU, or after launchDelay seconds
+  private async waitForReady(job: LaunchJob, account: Account): Promise<void> {
+    const deadline = Date.now() + job.options.launchDelay * 1000;
+    let lastCpu: number | null = null;
+
+    while (!job.cancelled && Date.now() < deadline) {
+      const info = this.processManager.getProcessInfo(account.id);
+      if (!info) {
+        // Exited during startup - nothing left to wait for
+        return;
+      }
+
+      if (info.pid > 0) {
+        await processSnapshot.getProcesses(this.READINESS_POLL_INTERVAL / 2);
+        const proc = processSnapshot.getCachedProcess(info.pid);
+        if (!proc) {
+          return;
+        }
+
+        if (proc.windowTitle) {
+          console.log(`✅ ${account.login} ready - window "${proc.windowTitle}" created`);
+          return;
+        }
+
+        if (lastCpu !== null && proc.cpuSeconds > 0) {
+          if (proc.cpuSeconds - lastCpu < this.CPU_SETTLE_SECONDS) {
+            console.log(`✅ ${account.login} ready - CPU usage settled`);
+            return;
+          }
+        }
+        lastCpu = proc.cpuSeconds;
+      }
+
+      await new Promise((resolve) => setTimeout(resolve, this.READINESS_POLL_INTERVAL));
+    }
+  }
+
+  private reportProgress(job: LaunchJob, state: JobProgress['state']): void {
+    const progress: JobProgress = {
+      jobId: job.id,
+      operation: 'launch',
+      state,
+      total: job.accounts.length,
+      done: job.launched,
+      failed: job.failed,
+      pending: job.cancelled ? 0 : job.queue.length,
+      active: Array.from(job.active),
+      throttled: job.throttled,
+    };
+    this.emit('progress', progress);
+  }
+
+  destroy(): void {
+    this.cancel();
+    this.removeAllListeners();
+  }
+}
+
+function clampPercent(value: number | undefined, fallback: number): number {
+  if (value === undefined || !Number.isFinite(value)) {
+    return fallback;
+  }
+  return Math.min(100, Math.max(10, value));
+}
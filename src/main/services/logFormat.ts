@@ -0,0 +1,112 @@
+// Log entry types and the text/NDJSON formats, free of Electron so the worker pool can
+// export logs off the main thread with exactly the same output
+
+export enum LogLevel {
+  DEBUG = 0,
+  INFO = 1,
+  WARN = 2,
+  ERROR = 3,
+  OPERATION = 4, // Special level for status bar operations
+}
+
+export interface LogEntry {
+  id: string;
+  timestamp: Date;
+  level: LogLevel;
+  message: string;
+  details?: any;
+  stackTrace?: string;
+  context?: string;
+}
+
+export interface LogFilter {
+  level?: LogLevel;
+  startDate?: Date;
+  endDate?: Date;
+  searchText?: string;
+  context?: string;
+}
+
+export function formatLogEntry(entry: LogEntry): string {
+  const levelStr = LogLevel[entry.level].padEnd(9);
+  const timestamp = entry.timestamp.toISOString();
+  let line = `[${timestamp}] [${levelStr}] ${entry.message}`;
+
+  if (entry.context) {
+    line += ` [${entry.context}]`;
+  }
+
+  if (entry.details) {
+    line += ` ${JSON.stringify(entry.details)}`;
+  }
+
+  if (entry.stackTrace) {
+    line += `\n${entry.stackTrace}`;
+  }
+
+  return line;
+}
+
+// Message, context and serialized details, lowercased for case-insensitive search
+export function searchableText(entry: LogEntry): string {
+  return [entry.message, entry.context || '', entry.details ? JSON.stringify(entry.details) : '']
+    .join('\n')
+    .toLowerCase();
+}
+
+export function matchesLogFilter(
+  entry: LogEntry,
+  filter: LogFilter,
+  getSearchText: (entry: LogEntry) => string = searchableText
+): boolean {
+  if (filter.level !== undefined && entry.level < filter.level) return false;
+  if (filter.context && entry.context !== filter.context) return false;
+  if (filter.startDate && entry.timestamp < filter.startDate) return false;
+  if (filter.endDate && entry.timestamp > filter.endDate) return false;
+
+  if (filter.searchText) {
+    return getSearchText(entry).includes(filter.searchText.toLowerCase());
+  }
+  return true;
+}
+
+// NDJSON record: short keys keep the file compact, optional fields are omitted
+export function toStructuredLine(entry: LogEntry): string {
+  const record: Record<string, unknown> = {
+    i: entry.id,
+    t: entry.timestamp.getTime(),
+    l: entry.level,
+    m: entry.message,
+  };
+  if (entry.context) record.c = entry.context;
+  if (entry.details !== undefined) record.d = entry.details;
+  if (entry.stackTrace) record.s = entry.stackTrace;
+
+  try {
+    return JSON.stringify(record) + '\n';
+  } catch {
+    // Circular details - keep the entry without them
+    delete record.d;
+    return JSON.stringify(record) + '\n';
+  }
+}
+
+export function parseStructuredLine(line: string): LogEntry | null {
+  if (!line) {
+    return null;
+  }
+  try {
+    const record = JSON.parse(line);
+    return {
+      id: record.i,
+      timestamp: new Date(record.t),
+      level: record.l,
+      message: record.m,
+      context: record.c,
+      details: record.d,
+      stackTrace: record.s,
+    };
+  } catch {
+    return null; // Torn write at the end of a file
+  }
+}
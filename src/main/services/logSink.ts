@@ -0,0 +1,121 @@
+import * as path from 'path';
+import * as fs from 'fs/promises';
+import { createWriteStream, WriteStream } from 'fs';
+import { once } from 'events';
+
+export interface RotatingFileSinkOptions {
+  maxBytes?: number; // Rotate before a write would grow the file past this
+  maxBackups?: number; // Rotated files kept next to the live one
+}
+
+// Append-only file kept open across writes. Rotation happens at write time: when the next
+// batch would exceed maxBytes the file is renamed to `<name>.<timestamp>.bak` and reopened.
+// Callers serialize writes (one in flight at a time).
+export class RotatingFileSink {
+  readonly filePath: string;
+  private readonly maxBytes: number;
+  private readonly maxBackups: number;
+  private stream: WriteStream | null = null;
+  private size = 0;
+
+  constructor(filePath: string, options: RotatingFileSinkOptions = {}) {
+    this.filePath = filePath;
+    this.maxBytes = options.maxBytes ?? 10 * 1024 * 1024;
+    this.maxBackups = options.maxBackups ?? 3;
+  }
+
+  async write(text: string): Promise<void> {
+    const bytes = Buffer.byteLength(text, 'utf8');
+    if (!this.stream) {
+      await this.open();
+    }
+    if (this.size > 0 && this.size + bytes > this.maxBytes) {
+      await this.rotate();
+    }
+
+    const stream = this.stream as WriteStream;
+    this.size += bytes;
+    if (!stream.write(text, 'utf8')) {
+      await once(stream, 'drain');
+    }
+  }
+
+  private async open(): Promise<void> {
+    await fs.mkdir(path.dirname(this.filePath), { recursive: true });
+    try {
+      this.size = (await fs.stat(this.filePath)).size;
+    } catch {
+      this.size = 0;
+    }
+
+    const stream = createWriteStream(this.filePath, { flags: 'a' });
+    stream.on('error', (error) => {
+      console.error(`Log sink ${path.basename(this.filePath)} failed:`, error);
+      if (this.stream === stream) {
+        this.stream = null; // Reopened on the next write
+      }
+    });
+    this.stream = stream;
+  }
+
+  // Rotated files oldest first, then the live file
+  async listFiles(): Promise<string[]> {
+    const dir = path.dirname(this.filePath);
+    const names = await this.readDir();
+    const files = this.backupNames(names).map((f) => path.join(dir, f));
+    if (names.includes(path.basename(this.filePath))) {
+      files.push(this.filePath);
+    }
+    return files;
+  }
+
+  async rotate(): Promise<void> {
+    await this.close();
+
+    try {
+      await fs.rename(this.filePath, `${this.filePath}.${Date.now()}.bak`);
+    } catch {
+      // Nothing to rotate
+    }
+    await this.pruneBackups();
+    await this.open();
+  }
+
+  private async pruneBackups(): Promise<void> {
+    const backups = this.backupNames(await this.readDir()).reverse();
+    for (let i = this.maxBackups; i < backups.length; i++) {
+      await fs.unlink(path.join(path.dirname(this.filePath), backups[i])).catch(() => {});
+    }
+  }
+
+  // `<name>.<timestamp>.bak` entries, oldest first
+  private backupNames(names: string[]): string[] {
+    const base = path.basename(this.filePath);
+    return names.filter((f) => f.startsWith(`${base}.`) && f.endsWith('.bak')).sort();
+  }
+
+  private async readDir(): Promise<string[]> {
+    try {
+      return await fs.readdir(path.dirname(this.filePath));
+    } catch {
+      return []; // Directory missing or unreadable - nothing written yet
+    }
+  }
+
+  // Flushes and closes the stream; the next write reopens it
+  async close(): Promise<void> {
+    const stream = this.stream;
+    this.stream = null;
+    if (stream && !stream.destroyed) {
+      stream.end();
+      await once(stream, 'close').catch(() => undefined);
+    }
+  }
+
+  // Closes and deletes the live file along with its rotated backups
+  async clear(): Promise<void> {
+    await this.close();
+    await Promise.all((await this.listFiles()).map((file) => fs.unlink(file).catch(() => {})));
+    this.size = 0;
+  }
+}
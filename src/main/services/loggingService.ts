@@ -1,47 +1,69 @@
-import { EventEmitter } from 'events';
-import * as fs from 'fs/promises';
+import { EventEmitter, once } from 'events';
+import { createWriteStream } from 'fs';
 import * as path from 'path';
 import { app } from 'electron';
-
-export enum LogLevel {
-  DEBUG = 0,
-  INFO = 1,
-  WARN = 2,
-  ERROR = 3,
-  OPERATION = 4, // Special level for status bar operations
+import { RingBuffer } from '../../shared/utils/ringBuffer';
+import {
+  formatLogEntry,
+  LogLevel,
+  matchesLogFilter,
+  searchableText,
+  toStructuredLine,
+} from './logFormat';
+import type { LogEntry, LogFilter } from './logFormat';
+import { RotatingFileSink } from './logSink';
+import { workerPool } from './workerPool';
+
+export { LogLevel };
+export type { LogEntry, LogFilter };
+
+// Messages for diagnostics that are usually off can be passed as a function; it only runs
+// when the entry will actually be recorded
+export type LogMessage = string | (() => string);
+
+export interface LogLevels {
+  level: LogLevel;
+  contexts: Record<string, LogLevel>; // Per-subsystem overrides of the global level
 }
 
-export interface LogEntry {
-  id: string;
-  timestamp: Date;
-  level: LogLevel;
-  message: string;
-  details?: any;
-  stackTrace?: string;
-  context?: string;
+export interface LogQuery extends LogFilter {
+  limit?: number; // Newest matches only
 }
 
-export interface LogFilter {
-  level?: LogLevel;
-  startDate?: Date;
-  endDate?: Date;
-  searchText?: string;
+export interface LogQueryResult {
+  total: number; // Matches before the limit
+  entries: LogEntry[];
 }
 
 export class LoggingService extends EventEmitter {
   private static instance: LoggingService;
-  private logs: LogEntry[] = [];
-  private readonly maxLogsInMemory = 1000; // Circular buffer size
+  private readonly maxLogsInMemory = 1000;
+  private logs: RingBuffer<LogEntry> = new RingBuffer(this.maxLogsInMemory);
+  private logsById: Map<string, LogEntry> = new Map();
+  private searchText: Map<string, string> = new Map(); // id -> lowercased searchable text
   private currentOperation: string | null = null;
   private logFile: string;
+  private textSink: RotatingFileSink;
+  private structuredSink: RotatingFileSink; // Compact NDJSON, one record per line
+  private structuredSinkEnabled = true;
   private writeQueue: LogEntry[] = [];
-  private isWriting = false;
+  private writing: Promise<void> | null = null;
   private logLevel: LogLevel = LogLevel.INFO;
+  private contextLevels: Map<string, LogLevel> = new Map();
 
   private constructor() {
     super();
-    this.logFile = path.join(app.getPath('userData'), 'app.log');
-    this.setupLogRotation();
+    const userDataPath = app.getPath('userData');
+    this.logFile = path.join(userDataPath, 'app.log');
+    this.textSink = new RotatingFileSink(this.logFile);
+    this.structuredSink = new RotatingFileSink(path.join(userDataPath, 'app.ndjson'));
+
+    // PW_LOG_DEBUG=LAUNCH,STORAGE turns on debug output for those subsystems from startup
+    for (const context of (process.env.PW_LOG_DEBUG || '').split(',')) {
+      if (context.trim()) {
+        this.contextLevels.set(context.trim().toUpperCase(), LogLevel.DEBUG);
+      }
+    }
   }
 
   static getInstance(): LoggingService {
@@ -52,82 +74,75 @@ export class LoggingService extends EventEmitter {
   }
 
   // Non-blocking log write with queue
-  private async writeToFile(entry: LogEntry): Promise<void> {
+  private writeToFile(entry: LogEntry): void {
     this.writeQueue.push(entry);
 
-    if (!this.isWriting) {
-      this.isWriting = true;
+    if (!this.writing) {
       // Process queue asynchronously
-      setImmediate(() => this.processWriteQueue());
+      this.writing = new Promise<void>((resolve) => setImmediate(resolve))
+        .then(() => this.processWriteQueue())
+        .finally(() => {
+          this.writing = null;
+        });
     }
   }
 
   private async processWriteQueue(): Promise<void> {
     while (this.writeQueue.length > 0) {
       const batch = this.writeQueue.splice(0, 50); // Process in batches
-      const lines = batch.map((entry) => this.formatLogEntry(entry)).join('\n') + '\n';
+      const lines = batch.map(formatLogEntry).join('\n') + '\n';
 
       try {
-        await fs.appendFile(this.logFile, lines, 'utf8');
+        await this.textSink.write(lines);
+        if (this.structuredSinkEnabled) {
+          await this.structuredSink.write(batch.map(toStructuredLine).join(''));
+        }
       } catch (error) {
         console.error('Failed to write logs to file:', error);
       }
     }
-
-    this.isWriting = false;
   }
 
-  private formatLogEntry(entry: LogEntry): string {
-    const levelStr = LogLevel[entry.level].padEnd(9);
-    const timestamp = entry.timestamp.toISOString();
-    let line = `[${timestamp}] [${levelStr}] ${entry.message}`;
-
-    if (entry.context) {
-      line += ` [${entry.context}]`;
-    }
-
-    if (entry.details) {
-      line += ` ${JSON.stringify(entry.details)}`;
+  // Resolves once everything logged so far has been handed to the sinks
+  private async drainWriteQueue(): Promise<void> {
+    while (this.writing) {
+      await this.writing;
     }
+  }
 
-    if (entry.stackTrace) {
-      line += `\n${entry.stackTrace}`;
-    }
+  // The NDJSON sink backs exportLogs beyond the in-memory buffer; it can be turned off
+  setStructuredSink(enabled: boolean): void {
+    this.structuredSinkEnabled = enabled;
+  }
 
-    return line;
+  setLogLevel(level: LogLevel): void {
+    this.logLevel = level;
   }
 
-  private async setupLogRotation(): Promise<void> {
-    try {
-      const stats = await fs.stat(this.logFile);
-      // Rotate log if larger than 10MB
-      if (stats.size > 10 * 1024 * 1024) {
-        const backupPath = `${this.logFile}.${Date.now()}.bak`;
-        await fs.rename(this.logFile, backupPath);
-
-        // Keep only last 3 backup files
-        const logDir = path.dirname(this.logFile);
-        const files = await fs.readdir(logDir);
-        const backups = files
-          .filter((f) => f.startsWith(path.basename(this.logFile)) && f.endsWith('.bak'))
-          .sort()
-          .reverse();
-
-        for (let i = 3; i < backups.length; i++) {
-          await fs.unlink(path.join(logDir, backups[i])).catch(() => {});
-        }
-      }
-    } catch (error) {
-      // File doesn't exist yet, that's fine
+  // Overrides the level for one subsystem; null falls back to the global level
+  setContextLevel(context: string, level: LogLevel | null): void {
+    if (level === null) {
+      this.contextLevels.delete(context);
+    } else {
+      this.contextLevels.set(context, level);
     }
   }
 
-  setLogLevel(level: LogLevel): void {
-    this.logLevel = level;
+  getLogLevels(): LogLevels {
+    return { level: this.logLevel, contexts: Object.fromEntries(this.contextLevels) };
+  }
+
+  // Guard for diagnostics too expensive to build even lazily in a single message
+  isEnabled(level: LogLevel, context?: string): boolean {
+    if (level === LogLevel.OPERATION) {
+      return true;
+    }
+    const override = context ? this.contextLevels.get(context) : undefined;
+    return level >= (override ?? this.logLevel);
   }
 
-  log(level: LogLevel, message: string, details?: any, context?: string): void {
-    if (level < this.logLevel && level !== LogLevel.OPERATION) {
+  log(level: LogLevel, message: LogMessage, details?: any, context?: string): void {
+    if (!this.isEnabled(level, context)) {
       return; // Skip logs below current level (except operations)
     }
 
@@ -135,7 +150,7 @@ export class LoggingService extends EventEmitter {
       id: `${Date.now()}-${Math.random().toString(36).substr(2, 9)}`,
       timestamp: new Date(),
       level,
-      message,
+      message: typeof message === 'function' ? message() : message,
       details,
       context,
     };
@@ -150,10 +165,12 @@ export class LoggingService extends EventEmitter {
       };
     }
 
-    // Add to circular buffer
-    this.logs.push(entry);
-    if (this.logs.length > this.maxLogsInMemory) {
-      this.logs.shift(); // Remove oldest
+    // Add to circular buffer; once full the oldest entry is overwritten
+    const evicted = this.logs.push(entry);
+    this.logsById.set(entry.id, entry);
+    if (evicted) {
+      this.logsById.delete(evicted.id);
+      this.searchText.delete(evicted.id);
     }
 
     // Write to file asynchronously
@@ -168,19 +185,19 @@ export class LoggingService extends EventEmitter {
   }
 
   // Convenience methods
-  debug(message: string, details?: any, context?: string): void {
+  debug(message: LogMessage, details?: any, context?: string): void {
     this.log(LogLevel.DEBUG, message, details, context);
   }
 
-  info(message: string, details?: any, context?: string): void {
+  info(message: LogMessage, details?: any, context?: string): void {
     this.log(LogLevel.INFO, message, details, context);
   }
 
-  warn(message: string, details?: any, context?: string): void {
+  warn(message: LogMessage, details?: any, context?: string): void {
     this.log(LogLevel.WARN, message, details, context);
   }
 
-  error(message: string, error?: Error | any, context?: string): void {
+  error(message: LogMessage, error?: Error | any, context?: string): void {
     this.log(LogLevel.ERROR, message, error, context);
   }
 
@@ -221,34 +238,38 @@ export class LoggingService extends EventEmitter {
 
   // Get logs with optional filtering
   getLogs(filter?: LogFilter): LogEntry[] {
-    let filtered = [...this.logs];
+    if (!filter) {
+      return this.logs.toArray();
+    }
+    return this.logs.filter((log) => this.matches(log, filter));
+  }
 
-    if (filter) {
-      if (filter.level !== undefined) {
-        filtered = filtered.filter((log) => log.level >= filter.level!);
-      }
+  // Filtered view for the log panel: one pass over the buffer, newest `limit` matches
+  queryLogs(query: LogQuery = {}): LogQueryResult {
+    const entries = this.getLogs(query);
+    const total = entries.length;
+    const limited =
+      query.limit !== undefined && total > query.limit ? entries.slice(-query.limit) : entries;
+    return { total, entries: limited };
+  }
 
-      if (filter.startDate) {
-        filtered = filtered.filter((log) => log.timestamp >= filter.startDate!);
-      }
+  getLogById(id: string): LogEntry | undefined {
+    return this.logsById.get(id);
+  }
 
-      if (filter.endDate) {
-        filtered = filtered.filter((log) => log.timestamp <= filter.endDate!);
-      }
+  private matches(log: LogEntry, filter: LogFilter): boolean {
+    return matchesLogFilter(log, filter, this.getSearchText);
+  }
 
-      if (filter.searchText) {
-        const search = filter.searchText.toLowerCase();
-        filtered = filtered.filter(
-          (log) =>
-            log.message.toLowerCase().includes(search) ||
-            (log.context && log.context.toLowerCase().includes(search)) ||
-            (log.details && JSON.stringify(log.details).toLowerCase().includes(search))
-        );
-      }
+  // Searchable text is built once per entry rather than per search
+  private getSearchText = (log: LogEntry): string => {
+    let text = this.searchText.get(log.id);
+    if (text === undefined) {
+      text = searchableText(log);
+      this.searchText.set(log.id, text);
     }
-
-    return filtered;
-  }
+    return text;
+  };
 
   // Get recent errors for quick access
   getRecentErrors(count: number = 10): LogEntry[] {
@@ -257,23 +278,61 @@ export class LoggingService extends EventEmitter {
 
   // Clear logs (both memory and file)
   async clearLogs(): Promise<void> {
-    this.logs = [];
+    this.logs.clear();
+    this.logsById.clear();
+    this.searchText.clear();
     this.writeQueue = [];
 
-    try {
-      await fs.unlink(this.logFile);
-    } catch (error) {
-      // File might not exist
-    }
+    await this.drainWriteQueue();
+    await Promise.all([this.textSink.clear(), this.structuredSink.clear()]);
 
     this.emit('logs-cleared');
   }
 
-  // Export logs to file
+  // Resolves once everything logged so far has reached the log files
+  async flush(): Promise<void> {
+    await this.drainWriteQueue();
+  }
+
+  // Export logs to file. With the NDJSON sink enabled this streams the whole on-disk history
+  // (rotated files first), not just the entries still held in memory. Reading, parsing and
+  // formatting that history runs on the worker pool.
   async exportLogs(outputPath: string, filter?: LogFilter): Promise<void> {
-    const logs = this.getLogs(filter);
-    const content = logs.map((log) => this.formatLogEntry(log)).join('\n');
-    await fs.writeFile(outputPath, content, 'utf8');
+    await this.drainWriteQueue();
+    // Closing flushes what the stream still buffers; the next write reopens it
+    await this.structuredSink.close();
+    const sources = this.structuredSinkEnabled ? await this.structuredSink.listFiles() : [];
+    if (sources.length > 0) {
+      await workerPool.run('exportLogs', { outputPath, sources, filter });
+      return;
+    }
+
+    // Only the in-memory buffer: at most maxLogsInMemory entries, whose details may not
+    // survive the copy to a worker
+    const output = createWriteStream(outputPath, { encoding: 'utf8' });
+    const failed = once(output, 'error').then(([error]) => Promise.reject(error));
+    failed.catch(() => undefined);
+    const write = async (text: string) => {
+      if (!output.write(text)) {
+        await Promise.race([once(output, 'drain'), failed]);
+      }
+    };
+
+    try {
+      let first = true;
+      for (const entry of this.logs.toArray()) {
+        if (!filter || this.matches(entry, filter)) {
+          await write((first ? '' : '\n') + formatLogEntry(entry));
+          first = false;
+        }
+      }
+
+      output.end();
+      await Promise.race([once(output, 'finish'), failed]);
+    } catch (error) {
+      output.destroy();
+      throw error;
+    }
   }
 
   // Format log entry for clipboard
@@ -299,7 +358,12 @@ export class LoggingService extends EventEmitter {
 
   destroy(): void {
     this.removeAllListeners();
-    this.logs = [];
+    void this.drainWriteQueue().then(() =>
+      Promise.all([this.textSink.close(), this.structuredSink.close()])
+    );
+    this.logs.clear();
+    this.logsById.clear();
+    this.searchText.clear();
     this.writeQueue = [];
     this.currentOperation = null;
   }
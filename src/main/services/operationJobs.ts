@@ -0,0 +1,123 @@
+import { JobOperation, JobProgress } from '../../shared/types';
+
+type JobUpdate = Partial<Omit<JobProgress, 'jobId' | 'operation'>>;
+
+interface TrackedJob {
+  progress: JobProgress;
+  timer: NodeJS.Timeout | null;
+  waiters: Array<(progress: JobProgress) => void>;
+}
+
+// Multi-account operations started over IPC. Each gets a job id up front; its progress is
+// sent coalesced to at most one message per frame-sized window, with the final state sent
+// straight away. Callers that only care about the outcome can wait() instead of following
+// the stream.
+export class OperationJobs {
+  private send: (progress: JobProgress) => void;
+  private readonly coalesceMs: number;
+  private jobs: Map<string, TrackedJob> = new Map();
+  private finished: Map<string, JobProgress> = new Map(); // Recent outcomes for late waiters
+  private nextJobId = 1;
+  private readonly MAX_FINISHED = 50;
+
+  constructor(send: (progress: JobProgress) => void, coalesceMs = 16) {
+    this.send = send;
+    this.coalesceMs = coalesceMs;
+  }
+
+  create(operation: JobOperation, total: number): string {
+    const jobId = `${operation}-${this.nextJobId++}`;
+    this.jobs.set(jobId, {
+      progress: {
+        jobId,
+        operation,
+        state: 'running',
+        total,
+        done: 0,
+        failed: 0,
+        pending: total,
+        active: [],
+      },
+      timer: null,
+      waiters: [],
+    });
+    this.schedule(jobId);
+    return jobId;
+  }
+
+  // Later updates within a window replace earlier ones; only the latest state is sent
+  report(jobId: string, update: JobUpdate): void {
+    const job = this.jobs.get(jobId);
+    if (!job) {
+      return;
+    }
+
+    job.progress = { ...job.progress, ...update };
+    if (job.progress.state === 'running') {
+      this.schedule(jobId);
+      return;
+    }
+
+    if (job.timer) {
+      clearTimeout(job.timer);
+    }
+    this.jobs.delete(jobId);
+    this.finished.set(jobId, job.progress);
+    if (this.finished.size > this.MAX_FINISHED) {
+      this.finished.delete(this.finished.keys().next().value as string);
+    }
+    this.send(job.progress);
+    job.waiters.forEach((resolve) => resolve(job.progress));
+  }
+
+  get(jobId: string): JobProgress | null {
+    return this.jobs.get(jobId)?.progress ?? this.finished.get(jobId) ?? null;
+  }
+
+  // Resolves with the job's final state, or its current state if timeoutMs passes first.
+  // Unknown (or long forgotten) job ids resolve with null.
+  wait(jobId: string, timeoutMs?: number): Promise<JobProgress | null> {
+    const job = this.jobs.get(jobId);
+    if (!job) {
+      return Promise.resolve(this.finished.get(jobId) ?? null);
+    }
+
+    return new Promise((resolve) => {
+      let timer: NodeJS.Timeout | null = null;
+      const waiter = (progress: JobProgress) => {
+        if (timer) clearTimeout(timer);
+        resolve(progress);
+      };
+      job.waiters.push(waiter);
+
+      if (timeoutMs !== undefined) {
+        timer = setTimeout(() => {
+          job.waiters = job.waiters.filter((w) => w !== waiter);
+          resolve(job.progress);
+        }, timeoutMs);
+      }
+    });
+  }
+
+  private schedule(jobId: string): void {
+    const job = this.jobs.get(jobId);
+    if (job && !job.timer) {
+      job.timer = setTimeout(() => {
+        job.timer = null;
+        this.send(job.progress);
+      }, this.coalesceMs);
+    }
+  }
+
+  destroy(): void {
+    for (const job of this.jobs.values()) {
+      if (job.timer) {
+        clearTimeout(job.timer);
+      }
+      // Don't leave awaiting renderer calls hanging on shutdown
+      job.waiters.forEach((resolve) => resolve(job.progress));
+    }
+    this.jobs.clear();
+    this.finished.clear();
+  }
+}
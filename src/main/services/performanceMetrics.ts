@@ -0,0 +1,193 @@
+import * as fs from 'fs/promises';
+import { performance } from 'perf_hooks';
+import { OperationStats, PerformanceSummary, RendererTiming } from '../../shared/types';
+import { RingBuffer } from '../../shared/utils/ringBuffer';
+
+// Chrome trace event format ("X" complete events, "C" counters, "M" metadata)
+export interface TraceEvent {
+  name: string;
+  cat: string;
+  ph: 'X' | 'C' | 'M';
+  ts: number; // Microseconds since the epoch
+  dur?: number;
+  pid: number;
+  tid: number;
+  args?: Record<string, unknown>;
+}
+
+type SpanArgs = Record<string, unknown>;
+
+const MAIN_THREAD = 1;
+const RENDERER_THREAD = 2;
+
+// Lifetime count and maximum plus a window of recent durations for the percentiles
+class Histogram {
+  count = 0;
+  total = 0;
+  max = 0;
+  private recent: RingBuffer<number>;
+
+  constructor(window: number) {
+    this.recent = new RingBuffer(window);
+  }
+
+  add(durationMs: number): void {
+    this.count++;
+    this.total += durationMs;
+    this.max = Math.max(this.max, durationMs);
+    this.recent.push(durationMs);
+  }
+
+  stats(name: string): OperationStats {
+    const samples = this.recent.toArray().sort((a, b) => a - b);
+    const at = (fraction: number) =>
+      samples.length > 0
+        ? samples[Math.min(samples.length - 1, Math.ceil(samples.length * fraction) - 1)]
+        : 0;
+    return {
+      name,
+      count: this.count,
+      p50Ms: round(at(0.5)),
+      p95Ms: round(at(0.95)),
+      maxMs: round(this.max),
+      meanMs: this.count > 0 ? round(this.total / this.count) : 0,
+    };
+  }
+}
+
+// Spans and counters for the hot paths (process snapshots, launches, IPC, table renders).
+// Each span feeds a per-operation histogram and a bounded trace buffer that can be saved
+// for chrome://tracing or Perfetto. Recording is a few arithmetic operations, so it stays on.
+export class PerformanceMetrics {
+  private histograms: Map<string, Histogram> = new Map();
+  private counters: Map<string, number> = new Map();
+  private trace: RingBuffer<TraceEvent>;
+  private readonly histogramWindow: number;
+
+  constructor(options: { traceCapacity?: number; histogramWindow?: number } = {}) {
+    this.trace = new RingBuffer(options.traceCapacity ?? 20000);
+    this.histogramWindow = options.histogramWindow ?? 1000;
+  }
+
+  // Starts timing `name`; call the returned function when the operation ends
+  startSpan(name: string, args?: SpanArgs): (endArgs?: SpanArgs) => number {
+    const startedAt = nowMs();
+    return (endArgs) => {
+      const durationMs = nowMs() - startedAt;
+      const allArgs = endArgs ? { ...args, ...endArgs } : args;
+      this.addSpan(name, startedAt, durationMs, MAIN_THREAD, allArgs);
+      return durationMs;
+    };
+  }
+
+  async time<T>(name: string, fn: () => Promise<T>, args?: SpanArgs): Promise<T> {
+    const end = this.startSpan(name, args);
+    try {
+      return await fn();
+    } finally {
+      end();
+    }
+  }
+
+  // For durations measured elsewhere, e.g. from a launch timestamp to PID association
+  record(name: string, durationMs: number, args?: SpanArgs): void {
+    this.addSpan(name, nowMs() - durationMs, durationMs, MAIN_THREAD, args);
+  }
+
+  recordRendererTimings(timings: RendererTiming[]): void {
+    for (const timing of timings) {
+      if (typeof timing?.name === 'string' && Number.isFinite(timing.durationMs)) {
+        this.addSpan(timing.name, timing.startedAt, timing.durationMs, RENDERER_THREAD);
+      }
+    }
+  }
+
+  increment(name: string, by = 1): void {
+    const value = (this.counters.get(name) ?? 0) + by;
+    this.counters.set(name, value);
+    this.trace.push({
+      name,
+      cat: 'counter',
+      ph: 'C',
+      ts: Math.round(nowMs() * 1000),
+      pid: 1,
+      tid: MAIN_THREAD,
+      args: { value },
+    });
+  }
+
+  getSummary(startup: Record<string, number> = {}): PerformanceSummary {
+    const operations = Array.from(this.histograms, ([name, histogram]) => histogram.stats(name));
+    return {
+      operations: operations.sort((a, b) => a.name.localeCompare(b.name)),
+      counters: Object.fromEntries(this.counters),
+      startup,
+    };
+  }
+
+  getTraceEvents(): TraceEvent[] {
+    const metadata = (name: string, tid: number, label: string): TraceEvent => ({
+      name,
+      cat: '__metadata',
+      ph: 'M',
+      ts: 0,
+      pid: 1,
+      tid,
+      args: { name: label },
+    });
+    return [
+      metadata('process_name', 0, 'PW Account Manager'),
+      metadata('thread_name', MAIN_THREAD, 'main'),
+      metadata('thread_name', RENDERER_THREAD, 'renderer'),
+      ...this.trace.toArray(),
+    ];
+  }
+
+  async exportTrace(filePath: string): Promise<void> {
+    const trace = { traceEvents: this.getTraceEvents(), displayTimeUnit: 'ms' };
+    await fs.writeFile(filePath, JSON.stringify(trace), 'utf-8');
+  }
+
+  reset(): void {
+    this.histograms.clear();
+    this.counters.clear();
+    this.trace.clear();
+  }
+
+  private addSpan(
+    name: string,
+    startedAt: number,
+    durationMs: number,
+    tid: number,
+    args?: SpanArgs
+  ): void {
+    let histogram = this.histograms.get(name);
+    if (!histogram) {
+      histogram = new Histogram(this.histogramWindow);
+      this.histograms.set(name, histogram);
+    }
+    histogram.add(durationMs);
+
+    this.trace.push({
+      name,
+      cat: name.split('.')[0],
+      ph: 'X',
+      ts: Math.round(startedAt * 1000),
+      dur: Math.round(durationMs * 1000),
+      pid: 1,
+      tid,
+      args,
+    });
+  }
+}
+
+// Epoch milliseconds with sub-millisecond resolution, comparable with the renderer's clock
+function nowMs(): number {
+  return performance.timeOrigin + performance.now();
+}
+
+function round(value: number): number {
+  return Math.round(value * 100) / 100;
+}
+
+export const metrics = new PerformanceMetrics();
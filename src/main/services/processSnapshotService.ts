@@ -0,0 +1,603 @@
+import { EventEmitter } from 'events';
+import { spawn, ChildProcess, exec } from 'child_process';
+import { promisify } from 'util';
+import { logger } from './loggingService';
+import { metrics } from './performanceMetrics';
+import { TtlCache } from '../../shared/utils/ttlCache';
+
+const execAsync = promisify(exec);
+
+export interface ElementClientProcess {
+  pid: number;
+  parentPid: number;
+  startTime: Date;
+  windowTitle: string;
+  cpuSeconds: number; // Total processor time, 0 when the source cannot report it
+  workingSetBytes: number; // Resident memory, 0 when the source cannot report it
+}
+
+interface PendingSnapshot {
+  resolve: (processes: ElementClientProcess[]) => void;
+  reject: (error: Error) => void;
+  timer: NodeJS.Timeout;
+}
+
+// Resident PowerShell host. Reads one command per line from stdin and answers with one
+// JSON line on stdout, so a snapshot costs a CIM query instead of a process spawn. While
+// watching it also pushes ElementClient.exe start/exit events as they happen. Commands:
+// `snapshot <id>`, `watch`, `unwatch`, `exit`.
+//
+// Stdin lines are read on a second runspace and re-raised as engine events, so the main loop
+// sleeps in Wait-Event until a command or a process event arrives instead of polling.
+//
+// Win32_ProcessStartTrace/StopTrace are delivered by the kernel as processes start and stop
+// and cost nothing in between, but subscribing to them needs an elevated token, and the
+// manager normally runs unelevated. Without it the host falls back to instance events, which
+// make WMI re-enumerate Win32_Process once a second; that only runs while clients are tracked.
+const SNAPSHOT_HOST_SCRIPT = `
+$ErrorActionPreference = 'SilentlyContinue'
+[Console]::OutputEncoding = [System.Text.Encoding]::UTF8
+function Write-Message($message) {
+  [Console]::Out.WriteLine((ConvertTo-Json -InputObject $message -Compress -Depth 3))
+  [Console]::Out.Flush()
+}
+function Get-Snapshot {
+  $titles = @{}
+  $cpu = @{}
+  $ws = @{}
+  Get-Process -Name ElementClient -ErrorAction SilentlyContinue | ForEach-Object {
+    $titles[$_.Id] = $_.MainWindowTitle
+    $cpu[$_.Id] = [double]$_.CPU
+    $ws[$_.Id] = [double]$_.WorkingSet64
+  }
+  Get-CimInstance Win32_Process -Filter "Name='ElementClient.exe'" | ForEach-Object {
+    @{
+      pid = [int]$_.ProcessId
+      ppid = [int]$_.ParentProcessId
+      created = $_.CreationDate.ToUniversalTime().ToString('o')
+      title = [string]$titles[[int]$_.ProcessId]
+      cpu = [double]$cpu[[int]$_.ProcessId]
+      ws = [double]$ws[[int]$_.ProcessId]
+    }
+  }
+}
+function Stop-Watching {
+  Unregister-Event -SourceIdentifier 'pw-exit'
+  Unregister-Event -SourceIdentifier 'pw-start'
+  Remove-Event -SourceIdentifier 'pw-exit'
+  Remove-Event -SourceIdentifier 'pw-start'
+}
+function Start-Watching {
+  Stop-Watching
+  try {
+    $trace = "WHERE ProcessName = 'ElementClient.exe'"
+    Register-CimIndicationEvent -Query "SELECT * FROM Win32_ProcessStopTrace $trace" -SourceIdentifier 'pw-exit' -ErrorAction Stop | Out-Null
+    Register-CimIndicationEvent -Query "SELECT * FROM Win32_ProcessStartTrace $trace" -SourceIdentifier 'pw-start' -ErrorAction Stop | Out-Null
+    return 'trace'
+  } catch {
+    Stop-Watching
+  }
+  $filter = "TargetInstance ISA 'Win32_Process' AND TargetInstance.Name = 'ElementClient.exe'"
+  Register-CimIndicationEvent -Query "SELECT * FROM __InstanceDeletionEvent WITHIN 1 WHERE $filter" -SourceIdentifier 'pw-exit' | Out-Null
+  Register-CimIndicationEvent -Query "SELECT * FROM __InstanceCreationEvent WITHIN 1 WHERE $filter" -SourceIdentifier 'pw-start' | Out-Null
+  return 'poll'
+}
+function Get-EventProcess($evt) {
+  $raised = $evt.SourceEventArgs.NewEvent
+  $target = $raised.TargetInstance
+  if ($target) {
+    $created = $target.CreationDate.ToUniversalTime()
+    $id = [int]$target.ProcessId
+    $parentId = [int]$target.ParentProcessId
+  } else {
+    $created = [DateTime]::UtcNow
+    if ($raised.TIME_CREATED) { $created = [DateTime]::FromFileTimeUtc([long]$raised.TIME_CREATED) }
+    $id = [int]$raised.ProcessID
+    $parentId = [int]$raised.ParentProcessID
+  }
+  @{ pid = $id; ppid = $parentId; created = $created.ToString('o'); title = ''; cpu = 0; ws = 0 }
+}
+$reader = [PowerShell]::Create()
+[void]$reader.AddScript({
+  param($events)
+  $stdin = New-Object System.IO.StreamReader([Console]::OpenStandardInput())
+  do {
+    $line = $stdin.ReadLine()
+    [void]$events.GenerateEvent('pw-stdin', $null, @($line), $null)
+  } while ($line -ne $null -and $line -ne 'exit')
+}).AddArgument($ExecutionContext.Events)
+[void]$reader.BeginInvoke()
+Write-Message @{ type = 'ready' }
+:commands while ($true) {
+  $evt = Wait-Event
+  Remove-Event -EventIdentifier $evt.EventIdentifier
+  if ($evt.SourceIdentifier -eq 'pw-stdin') {
+    $line = $evt.SourceArgs[0]
+    if ($line -eq $null -or $line -eq 'exit') { break commands }
+    $parts = $line.Split(' ')
+    if ($parts[0] -eq 'snapshot') {
+      Write-Message @{ type = 'snapshot'; id = $parts[1]; processes = @(Get-Snapshot) }
+    } elseif ($parts[0] -eq 'watch') {
+      Write-Message @{ type = 'watching'; mode = (Start-Watching) }
+    } elseif ($parts[0] -eq 'unwatch') {
+      Stop-Watching
+    }
+  } elseif ($evt.SourceIdentifier -eq 'pw-exit') {
+    Write-Message @{ type = 'exit'; pid = (Get-EventProcess $evt).pid }
+  } elseif ($evt.SourceIdentifier -eq 'pw-start') {
+    Write-Message @{ type = 'start'; process = (Get-EventProcess $evt) }
+  }
+}
+Stop-Watching
+`;
+
+export class ProcessSnapshotService extends EventEmitter {
+  private static instance: ProcessSnapshotService;
+  private host: ChildProcess | null = null;
+  private stdoutBuffer = '';
+  private nextRequestId = 1;
+  private pending: Map<string, PendingSnapshot> = new Map();
+  private inFlight: Promise<ElementClientProcess[]> | null = null;
+  private table: Map<number, ElementClientProcess> = new Map();
+  private livenessCache: TtlCache<number, boolean>;
+  private lastRefresh = 0;
+  private hostFailures = 0;
+  private eventsAvailable = false;
+  private watching = false; // Process events wanted; re-sent to a restarted host
+  private watchSent = false; // `watch` already sent to the current host
+  private readonly MAX_HOST_FAILURES = 3; // After this many crashes fall back to one-shot tasklist
+  private readonly SNAPSHOT_TIMEOUT = 8000;
+  private readonly DEFAULT_MAX_AGE = 1000; // Callers within this window share one snapshot
+  private readonly LIVENESS_TTL = 2000; // How long an alive/dead verdict is reused without a new snapshot
+
+  private constructor() {
+    super();
+    this.livenessCache = new TtlCache(this.LIVENESS_TTL);
+  }
+
+  static getInstance(): ProcessSnapshotService {
+    if (!ProcessSnapshotService.instance) {
+      ProcessSnapshotService.instance = new ProcessSnapshotService();
+    }
+    return ProcessSnapshotService.instance;
+  }
+
+  // Returns the ElementClient.exe table, refreshing it only if it is older than maxAgeMs
+  async getProcesses(maxAgeMs: number = this.DEFAULT_MAX_AGE): Promise<ElementClientProcess[]> {
+    if (process.platform !== 'win32') {
+      return [];
+    }
+
+    if (this.lastRefresh > 0 && Date.now() - this.lastRefresh <= maxAgeMs) {
+      return Array.from(this.table.values());
+    }
+
+    return this.refresh();
+  }
+
+  getCachedProcess(pid: number): ElementClientProcess | undefined {
+    return this.table.get(pid);
+  }
+
+  // ElementClient.exe processes in the table that are rootPid itself or descend from it.
+  // Children must have started after `since` so a recycled parent PID cannot adopt old clients.
+  findProcessTree(rootPid: number, since: Date): ElementClientProcess[] {
+    const tree = new Set<number>([rootPid]);
+    const minStart = since.getTime() - 2000; // Allow clock skew between WMI and Node
+    let grew = true;
+
+    while (grew) {
+      grew = false;
+      for (const proc of this.table.values()) {
+        if (
+          !tree.has(proc.pid) &&
+          tree.has(proc.parentPid) &&
+          proc.startTime.getTime() >= minStart
+        ) {
+          tree.add(proc.pid);
+          grew = true;
+        }
+      }
+    }
+
+    return Array.from(this.table.values()).filter((proc) => tree.has(proc.pid));
+  }
+
+  // Resolves alive/dead for every PID at once. Cached verdicts are reused; if any PID has no
+  // fresh verdict a single snapshot is taken and answers all of them.
+  async checkLiveness(pids: number[]): Promise<Map<number, boolean>> {
+    const result = new Map<number, boolean>();
+    if (process.platform !== 'win32') {
+      for (const pid of pids) {
+        result.set(pid, false);
+      }
+      return result;
+    }
+
+    const unknown = pids.filter((pid) => !this.livenessCache.has(pid));
+    if (unknown.length > 0) {
+      await this.refresh();
+      for (const pid of unknown) {
+        this.livenessCache.set(pid, this.table.has(pid));
+      }
+    }
+
+    for (const pid of pids) {
+      result.set(pid, this.livenessCache.get(pid) ?? this.table.has(pid));
+    }
+    return result;
+  }
+
+  // Forces a new snapshot; concurrent callers share the same in-flight request
+  async refresh(): Promise<ElementClientProcess[]> {
+    if (process.platform !== 'win32') {
+      return [];
+    }
+
+    if (!this.inFlight) {
+      this.inFlight = metrics
+        .time('process.snapshot', () => this.takeSnapshot())
+        .then((processes) => {
+          this.updateTable(processes);
+          return processes;
+        })
+        .finally(() => {
+          this.inFlight = null;
+        });
+    }
+
+    return this.inFlight;
+  }
+
+  private updateTable(processes: ElementClientProcess[]): void {
+    const next = new Map<number, ElementClientProcess>();
+    for (const proc of processes) {
+      next.set(proc.pid, proc);
+    }
+
+    // A full snapshot is authoritative: confirm everything in it and expire stale verdicts
+    this.livenessCache.clear();
+    for (const pid of next.keys()) {
+      this.livenessCache.set(pid, true);
+    }
+
+    this.table = next;
+    this.lastRefresh = Date.now();
+    this.emit('snapshot', processes);
+  }
+
+  private async takeSnapshot(): Promise<ElementClientProcess[]> {
+    if (this.hostFailures >= this.MAX_HOST_FAILURES) {
+      return this.takeTasklistSnapshot();
+    }
+
+    try {
+      return await this.requestFromHost();
+    } catch (error) {
+      logger.warn(
+        'Snapshot host request failed, using tasklist fallback',
+        error,
+        'PROCESS_SNAPSHOT'
+      );
+      return this.takeTasklistSnapshot();
+    }
+  }
+
+  private ensureHost(): ChildProcess {
+    if (this.host && this.host.exitCode === null && !this.host.killed) {
+      return this.host;
+    }
+
+    const encodedScript = Buffer.from(SNAPSHOT_HOST_SCRIPT, 'utf16le').toString('base64');
+    const host = spawn(
+      'powershell.exe',
+      [
+        '-NoLogo',
+        '-NoProfile',
+        '-NonInteractive',
+        '-ExecutionPolicy',
+        'Bypass',
+        '-EncodedCommand',
+        encodedScript,
+      ],
+      { stdio: ['pipe', 'pipe', 'ignore'], windowsHide: true }
+    );
+
+    this.stdoutBuffer = '';
+    host.stdout?.setEncoding('utf8');
+    host.stdout?.on('data', (chunk: string) => this.handleHostOutput(chunk));
+
+    host.on('error', (error) => {
+      logger.error('Snapshot host failed to start', error, 'PROCESS_SNAPSHOT');
+      this.handleHostExit(host);
+    });
+
+    host.on('exit', (code) => {
+      logger.warn(`Snapshot host exited with code ${code}`, null, 'PROCESS_SNAPSHOT');
+      this.handleHostExit(host);
+    });
+
+    // EPIPE / ERR_STREAM_DESTROYED when the host died before a request reached it; without a
+    // listener this would be an uncaught exception in the main process
+    host.stdin?.on('error', (error) => {
+      logger.warn('Snapshot host input closed', error, 'PROCESS_SNAPSHOT');
+      this.handleHostExit(host);
+      if (host.exitCode === null && !host.killed) {
+        host.kill();
+      }
+    });
+
+    logger.info(`Started resident snapshot host (PID ${host.pid})`, null, 'PROCESS_SNAPSHOT');
+    this.host = host;
+    this.watchSent = false;
+    if (this.watching) {
+      this.sendWatch(host);
+    }
+    return host;
+  }
+
+  private handleHostExit(host: ChildProcess): void {
+    if (this.host !== host) {
+      return;
+    }
+
+    this.host = null;
+    this.hostFailures++;
+    const hadEvents = this.eventsAvailable;
+    this.eventsAvailable = false;
+
+    // Fail everything waiting on this host so callers can fall back immediately
+    for (const [id, request] of this.pending.entries()) {
+      clearTimeout(request.timer);
+      request.reject(new Error('Snapshot host exited'));
+      this.pending.delete(id);
+    }
+
+    // Exits that happened while the host was down were never reported - let listeners reconcile
+    this.livenessCache.clear();
+    if (hadEvents) {
+      this.emit('host-lost');
+    }
+  }
+
+  private requestFromHost(): Promise<ElementClientProcess[]> {
+    return new Promise((resolve, reject) => {
+      const host = this.ensureHost();
+      const id = String(this.nextRequestId++);
+
+      const timer = setTimeout(() => {
+        this.pending.delete(id);
+        reject(new Error(`Snapshot request ${id} timed out`));
+      }, this.SNAPSHOT_TIMEOUT);
+
+      this.pending.set(id, { resolve, reject, timer });
+      host.stdin?.write(`snapshot ${id}\n`);
+    });
+  }
+
+  private handleHostOutput(chunk: string): void {
+    this.stdoutBuffer += chunk;
+
+    let newlineIndex = this.stdoutBuffer.indexOf('\n');
+    while (newlineIndex !== -1) {
+      const line = this.stdoutBuffer.substring(0, newlineIndex).trim();
+      this.stdoutBuffer = this.stdoutBuffer.substring(newlineIndex + 1);
+      if (line) {
+        this.handleHostLine(line);
+      }
+      newlineIndex = this.stdoutBuffer.indexOf('\n');
+    }
+  }
+
+  private handleHostLine(line: string): void {
+    let message: any;
+    try {
+      message = JSON.parse(line);
+    } catch {
+      logger.debug('Ignoring non-JSON snapshot host output', { line }, 'PROCESS_SNAPSHOT');
+      return;
+    }
+
+    if (message.type === 'ready') {
+      return;
+    }
+
+    if (message.type === 'watching') {
+      this.eventsAvailable = true;
+      logger.info(
+        message.mode === 'trace'
+          ? 'Watching ElementClient.exe through process trace events'
+          : 'Watching ElementClient.exe through WMI instance events (not elevated)',
+        null,
+        'PROCESS_SNAPSHOT'
+      );
+      this.emit('host-ready');
+      return;
+    }
+
+    if (message.type === 'exit') {
+      this.handleProcessExit(message.pid);
+      return;
+    }
+
+    if (message.type === 'start') {
+      const [started] = parseHostProcesses([message.process]);
+      if (started) {
+        this.table.set(started.pid, started);
+        this.livenessCache.set(started.pid, true);
+        this.emit('process-start', started);
+      }
+      return;
+    }
+
+    const request = this.pending.get(String(message.id));
+    if (!request) {
+      return;
+    }
+
+    clearTimeout(request.timer);
+    this.pending.delete(String(message.id));
+    this.hostFailures = 0;
+    request.resolve(parseHostProcesses(message.processes));
+  }
+
+  private handleProcessExit(pid: number): void {
+    if (!Number.isInteger(pid)) {
+      return;
+    }
+
+    this.table.delete(pid);
+    this.livenessCache.set(pid, false);
+    logger.debug(`ElementClient.exe PID ${pid} exited`, { pid }, 'PROCESS_SNAPSHOT');
+    this.emit('process-exit', pid);
+  }
+
+  // Starts the resident host so exit/start events flow even when nobody asks for snapshots
+  startWatching(): void {
+    if (process.platform !== 'win32' || this.hostFailures >= this.MAX_HOST_FAILURES) {
+      return;
+    }
+
+    this.watching = true;
+    this.sendWatch(this.ensureHost());
+  }
+
+  // Drops the event subscriptions once no client is tracked. An idle host is shut down; a later
+  // snapshot starts a fresh one without subscriptions.
+  stopWatching(): void {
+    if (!this.watching) {
+      return;
+    }
+    this.watching = false;
+    this.eventsAvailable = false;
+
+    const host = this.host;
+    if (!host) {
+      return;
+    }
+    if (this.pending.size > 0) {
+      host.stdin?.write('unwatch\n'); // Still owes a snapshot answer; keep it running
+      this.watchSent = false;
+      return;
+    }
+
+    this.host = null; // A requested exit, not a failure - handleHostExit ignores it
+    host.stdin?.end('exit\n');
+    logger.info(
+      'Stopped watching ElementClient.exe, snapshot host shut down',
+      null,
+      'PROCESS_SNAPSHOT'
+    );
+  }
+
+  private sendWatch(host: ChildProcess): void {
+    if (!this.watchSent) {
+      this.watchSent = true;
+      host.stdin?.write('watch\n');
+    }
+  }
+
+  // True while the resident host is delivering process exit events
+  supportsExitEvents(): boolean {
+    return this.eventsAvailable && this.host !== null;
+  }
+
+  private async takeTasklistSnapshot(): Promise<ElementClientProcess[]> {
+    try {
+      const { stdout } = await execAsync(
+        `tasklist /fi "imagename eq ElementClient.exe" /fo csv /nh`,
+        { timeout: 3000 }
+      );
+      return parseTasklistOutput(stdout);
+    } catch (error) {
+      logger.error('Tasklist snapshot failed', error, 'PROCESS_SNAPSHOT');
+      return [];
+    }
+  }
+
+  destroy(): void {
+    for (const request of this.pending.values()) {
+      clearTimeout(request.timer);
+      request.reject(new Error('Snapshot service destroyed'));
+    }
+    this.pending.clear();
+
+    if (this.host) {
+      const host = this.host;
+      this.host = null;
+      try {
+        host.stdin?.write('exit\n');
+        host.kill();
+      } catch {
+        // Host already gone
+      }
+    }
+
+    this.table.clear();
+    this.livenessCache.clear();
+    this.lastRefresh = 0;
+    this.eventsAvailable = false;
+    this.watching = false;
+    this.removeAllListeners();
+  }
+}
+
+// The client a launch tree settles on: a member that spawned no other member, newest first
+export function selectTreeLeaf(tree: ElementClientProcess[]): ElementClientProcess | undefined {
+  const parents = new Set(tree.map((proc) => proc.parentPid));
+  const leaves = tree.filter((proc) => !parents.has(proc.pid));
+  return leaves.reduce<ElementClientProcess | undefined>(
+    (newest, proc) => (!newest || proc.startTime > newest.startTime ? proc : newest),
+    undefined
+  );
+}
+
+export function parseHostProcesses(raw: any): ElementClientProcess[] {
+  if (!raw) {
+    return [];
+  }
+
+  // ConvertTo-Json collapses single-element arrays into a bare object
+  const entries: any[] = Array.isArray(raw) ? raw : [raw];
+
+  return entries
+    .filter((entry) => entry && Number.isInteger(entry.pid))
+    .map((entry) => {
+      const created = entry.created ? new Date(entry.created) : new Date();
+      return {
+        pid: entry.pid,
+        parentPid: Number.isInteger(entry.ppid) ? entry.ppid : 0,
+        startTime: isNaN(created.getTime()) ? new Date() : created,
+        windowTitle: typeof entry.title === 'string' ? entry.title : '',
+        cpuSeconds: typeof entry.cpu === 'number' ? entry.cpu : 0,
+        workingSetBytes: typeof entry.ws === 'number' ? entry.ws : 0,
+      };
+    });
+}
+
+export function parseTasklistOutput(stdout: string): ElementClientProcess[] {
+  const processes: ElementClientProcess[] = [];
+
+  // CSV format: "Image Name","PID","Session Name","Session#","Mem Usage"
+  for (const line of stdout.split('\n')) {
+    const match = line.match(/"ElementClient\.exe","(\d+)"/i);
+    if (match) {
+      // Fifth column is the working set, e.g. "1,234,567 K" with locale-specific separators
+      const memUsage = line.trim().split('","')[4] || '';
+      const memKb = parseInt(memUsage.replace(/\D/g, ''), 10);
+      processes.push({
+        pid: parseInt(match[1]),
+        parentPid: 0,
+        startTime: new Date(), // tasklist has no creation time
+        windowTitle: '',
+        cpuSeconds: 0,
+        workingSetBytes: isNaN(memKb) ? 0 : memKb * 1024,
+      });
+    }
+  }
+
+  return processes;
+}
+
+// Export singleton instance
+export const processSnapshot = ProcessSnapshotService.getInstance();
@@ -0,0 +1,188 @@
+import * as os from 'os';
+import { EventEmitter } from 'events';
+import { ClientResources, SystemUsage } from '../../shared/types';
+import { GameProcessManager } from './gameProcessManager';
+import { processSnapshot } from './processSnapshotService';
+
+interface CpuTimes {
+  idle: number;
+  total: number;
+}
+
+interface CpuSample {
+  cpuSeconds: number;
+  at: number;
+}
+
+// System CPU/memory and per-client usage. System figures come from os counters; client
+// figures come from the same process snapshots the rest of the app uses. While clients are
+// running it samples every few seconds and emits 'update' with usage by account id.
+export class ResourceMonitor extends EventEmitter {
+  private processManager: GameProcessManager;
+  private timer: NodeJS.Timeout | null = null;
+  private readonly SAMPLE_INTERVAL = 5000;
+  private readonly DEFAULT_FOOTPRINT = 1024 * 1024 * 1024; // Per client until one is measured
+  private lastCpuTimes: CpuTimes = readCpuTimes();
+  private lastCpuTimesAt = Date.now();
+  private lastSystem: SystemUsage | null = null;
+  private clientCpu: Map<number, CpuSample> = new Map(); // By PID
+  private clients: Map<string, ClientResources> = new Map(); // By account id
+  private footprints: Map<string, number> = new Map(); // Peak working set by account id
+
+  constructor(processManager: GameProcessManager) {
+    super();
+    this.processManager = processManager;
+    this.processManager.on('status-update', this.handleStatusUpdate);
+    this.processManager.on('status-update-batch', this.handleStatusBatch);
+  }
+
+  private handleStatusUpdate = (accountId: string, isRunning: boolean): void => {
+    if (!isRunning) {
+      this.clients.delete(accountId);
+    }
+    this.updateSampling();
+  };
+
+  // Bulk closes report every account in one event
+  private handleStatusBatch = (updates: { accountId: string; running: boolean }[]): void => {
+    let removed = false;
+    for (const update of updates) {
+      if (!update.running) {
+        removed = this.clients.delete(update.accountId) || removed;
+      }
+    }
+    this.updateSampling();
+    if (removed && this.timer) {
+      this.emit('update', this.getClientResources()); // Drop the closed rows before the next sample
+    }
+  };
+
+  // Samples only while at least one client is running
+  private updateSampling(): void {
+    if (this.processManager.getRunningProcesses().length > 0) {
+      if (!this.timer) {
+        this.timer = setInterval(() => {
+          this.sampleClients().catch((error) =>
+            console.warn('📊 Resource sample failed:', error)
+          );
+        }, this.SAMPLE_INTERVAL);
+      }
+    } else if (this.timer) {
+      clearInterval(this.timer);
+      this.timer = null;
+      this.clientCpu.clear();
+      this.emit('update', {});
+    }
+  }
+
+  // Whole-machine CPU since the previous sample (at least 250ms of it) and current memory
+  async sampleSystem(): Promise<SystemUsage> {
+    let elapsed = Date.now() - this.lastCpuTimesAt;
+    if (elapsed < 250) {
+      if (this.lastSystem) {
+        return this.lastSystem;
+      }
+      await new Promise((resolve) => setTimeout(resolve, 250 - elapsed));
+      elapsed = 250;
+    }
+
+    const times = readCpuTimes();
+    const idle = times.idle - this.lastCpuTimes.idle;
+    const total = times.total - this.lastCpuTimes.total;
+    this.lastCpuTimes = times;
+    this.lastCpuTimesAt = Date.now();
+
+    const totalMemoryBytes = os.totalmem();
+    const freeMemoryBytes = os.freemem();
+    this.lastSystem = {
+      cpuPercent: total > 0 ? Math.round((1 - idle / total) * 1000) / 10 : 0,
+      memoryPercent: Math.round((1 - freeMemoryBytes / totalMemoryBytes) * 1000) / 10,
+      totalMemoryBytes,
+      freeMemoryBytes,
+    };
+    return this.lastSystem;
+  }
+
+  // CPU share and working set of every running client with a known PID
+  async sampleClients(): Promise<Record<string, ClientResources>> {
+    await processSnapshot.getProcesses(this.SAMPLE_INTERVAL / 2);
+    const now = Date.now();
+    const cpuCount = os.cpus().length || 1;
+    const seenPids = new Set<number>();
+
+    for (const info of this.processManager.getRunningProcesses()) {
+      const proc = info.pid > 0 ? processSnapshot.getCachedProcess(info.pid) : undefined;
+      if (!proc) {
+        continue;
+      }
+      seenPids.add(proc.pid);
+
+      const previous = this.clientCpu.get(proc.pid);
+      this.clientCpu.set(proc.pid, { cpuSeconds: proc.cpuSeconds, at: now });
+      const cpuPercent =
+        previous && now > previous.at
+          ? ((proc.cpuSeconds - previous.cpuSeconds) / ((now - previous.at) / 1000) / cpuCount) *
+            100
+          : 0;
+
+      this.clients.set(info.accountId, {
+        cpuPercent: Math.max(0, Math.round(cpuPercent * 10) / 10),
+        workingSetBytes: proc.workingSetBytes,
+      });
+      if (proc.workingSetBytes > (this.footprints.get(info.accountId) ?? 0)) {
+        this.footprints.set(info.accountId, proc.workingSetBytes);
+      }
+    }
+
+    for (const pid of this.clientCpu.keys()) {
+      if (!seenPids.has(pid)) {
+        this.clientCpu.delete(pid);
+      }
+    }
+
+    const update = this.getClientResources();
+    this.emit('update', update);
+    return update;
+  }
+
+  getClientResources(): Record<string, ClientResources> {
+    return Object.fromEntries(this.clients);
+  }
+
+  // Memory a client of this account is expected to take once loaded: its own peak if it has
+  // run before, otherwise the average peak of the clients measured so far
+  expectedFootprint(accountId: string): number {
+    const own = this.footprints.get(accountId);
+    if (own) {
+      return own;
+    }
+    if (this.footprints.size === 0) {
+      return this.DEFAULT_FOOTPRINT;
+    }
+    let sum = 0;
+    for (const bytes of this.footprints.values()) {
+      sum += bytes;
+    }
+    return sum / this.footprints.size;
+  }
+
+  destroy(): void {
+    if (this.timer) {
+      clearInterval(this.timer);
+      this.timer = null;
+    }
+    this.processManager.off('status-update', this.handleStatusUpdate);
+    this.processManager.off('status-update-batch', this.handleStatusBatch);
+    this.removeAllListeners();
+  }
+}
+
+function readCpuTimes(): CpuTimes {
+  let idle = 0;
+  let total = 0;
+  for (const cpu of os.cpus()) {
+    idle += cpu.times.idle;
+    total += cpu.times.user + cpu.times.nice + cpu.times.sys + cpu.times.idle + cpu.times.irq;
+  }
+  return { idle, total };
+}
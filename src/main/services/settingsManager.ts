@@ -1,22 +1,44 @@
 import Store from 'electron-store';
+import { EventEmitter } from 'events';
 import { Settings } from '../../shared/types';
 import * as path from 'path';
 import * as fs from 'fs/promises';
+import { CoalescedFileWriter } from './coalescedFileWriter';
 
 interface StoreSchema {
   settings: Settings;
 }
 
+type WindowBounds = NonNullable<Settings['windowBounds']>;
+
+export type SettingChangeListener<K extends keyof Settings> = (
+  value: Settings[K],
+  previous: Settings[K]
+) => void;
+
+// Settings are read from electron-store once and then served from memory. Changes notify
+// subscribers per key and reach disk through a coalesced temp-file-and-rename write, so
+// neither reads nor writes touch the disk on the main process event loop.
 export class SettingsManager {
+  private static instance: SettingsManager;
   private store: Store<StoreSchema>;
+  private stored: Record<string, unknown>; // Whole store file, including keys other than settings
+  private settings: Settings;
+  private writer: CoalescedFileWriter;
+  private changes = new EventEmitter();
   private defaultSettings: Settings = {
     gamePath: '',
     launchDelay: 15, // Changed default to 15 seconds (within 10-60 range)
+    maxConcurrentLaunches: 2,
+    launchCpuLimit: 85,
+    launchMemoryLimit: 90,
+    scanMaxDepth: 5,
+    scanMaxFiles: 1000,
     processMonitoringMode: '3min', // Default to 3-minute monitoring interval
     autoRestartCrashedClients: false, // Default to manual restart only
   };
 
-  constructor() {
+  private constructor() {
     this.store = new Store<StoreSchema>({
       defaults: {
         settings: this.defaultSettings,
@@ -33,6 +55,31 @@ export class SettingsManager {
               minimum: 1,
               maximum: 30,
             },
+            maxConcurrentLaunches: {
+              type: 'number',
+              minimum: 1,
+              maximum: 10,
+            },
+            launchCpuLimit: {
+              type: 'number',
+              minimum: 10,
+              maximum: 100,
+            },
+            launchMemoryLimit: {
+              type: 'number',
+              minimum: 10,
+              maximum: 100,
+            },
+            scanMaxDepth: {
+              type: 'number',
+              minimum: 1,
+              maximum: 20,
+            },
+            scanMaxFiles: {
+              type: 'number',
+              minimum: 1,
+              maximum: 100000,
+            },
             windowBounds: {
               type: 'object',
               properties: {
@@ -47,10 +94,37 @@ export class SettingsManager {
         },
       },
     });
+
+    this.stored = { ...this.store.store };
+    this.settings = { ...this.defaultSettings, ...this.store.get('settings') };
+    this.writer = new CoalescedFileWriter(this.store.path, () =>
+      JSON.stringify({ ...this.stored, settings: this.settings }, undefined, '\t')
+    );
+    this.changes.setMaxListeners(50);
+  }
+
+  static getInstance(): SettingsManager {
+    if (!SettingsManager.instance) {
+      SettingsManager.instance = new SettingsManager();
+    }
+    return SettingsManager.instance;
   }
 
   async getSettings(): Promise<Settings> {
-    return this.store.get('settings');
+    return this.getCachedSettings();
+  }
+
+  // Synchronous read for hot paths; a copy, so callers cannot change the cache
+  getCachedSettings(): Settings {
+    return { ...this.settings };
+  }
+
+  // Calls `listener` whenever `key` changes value; returns the unsubscribe function
+  onChange<K extends keyof Settings>(key: K, listener: SettingChangeListener<K>): () => void {
+    this.changes.on(key, listener);
+    return () => {
+      this.changes.off(key, listener);
+    };
   }
 
   async saveSettings(settings: Settings): Promise<void> {
@@ -58,6 +132,41 @@ export class SettingsManager {
       throw new Error('Launch delay must be between 1 and 30 seconds');
     }
 
+    if (
+      settings.maxConcurrentLaunches !== undefined &&
+      (settings.maxConcurrentLaunches < 1 || settings.maxConcurrentLaunches > 10)
+    ) {
+      throw new Error('Concurrent launches must be between 1 and 10');
+    }
+
+    if (
+      settings.launchCpuLimit !== undefined &&
+      (settings.launchCpuLimit < 10 || settings.launchCpuLimit > 100)
+    ) {
+      throw new Error('CPU launch limit must be between 10 and 100 percent');
+    }
+
+    if (
+      settings.launchMemoryLimit !== undefined &&
+      (settings.launchMemoryLimit < 10 || settings.launchMemoryLimit > 100)
+    ) {
+      throw new Error('Memory launch limit must be between 10 and 100 percent');
+    }
+
+    if (
+      settings.scanMaxDepth !== undefined &&
+      (settings.scanMaxDepth < 1 || settings.scanMaxDepth > 20)
+    ) {
+      throw new Error('Scan depth must be between 1 and 20');
+    }
+
+    if (
+      settings.scanMaxFiles !== undefined &&
+      (settings.scanMaxFiles < 1 || settings.scanMaxFiles > 100000)
+    ) {
+      throw new Error('Scan file limit must be between 1 and 100000');
+    }
+
     if (settings.gamePath) {
       // Check for elementclient.exe in multiple locations with case-insensitive search
       const possiblePaths = [settings.gamePath, path.join(settings.gamePath, 'element')];
@@ -92,16 +201,44 @@ export class SettingsManager {
       }
     }
 
-    this.store.set('settings', settings);
+    // The settings dialog does not send the window bounds
+    const windowBounds = settings.windowBounds ?? this.settings.windowBounds;
+    this.update({ ...settings, windowBounds });
+  }
+
+  saveWindowBounds(bounds: WindowBounds): void {
+    const { x, y, width, height } = bounds;
+    this.update({ ...this.settings, windowBounds: { x, y, width, height } });
+  }
+
+  getWindowBounds(): WindowBounds | undefined {
+    return this.settings.windowBounds;
   }
 
-  saveWindowBounds(bounds: { x: number; y: number; width: number; height: number }): void {
-    const settings = this.store.get('settings');
-    settings.windowBounds = bounds;
-    this.store.set('settings', settings);
+  // Writes anything still pending; resolves once it is on disk
+  flush(): Promise<void> {
+    return this.writer.flush();
   }
 
-  getWindowBounds(): { x: number; y: number; width: number; height: number } | undefined {
-    return this.store.get('settings').windowBounds;
+  // Shutdown: the last write has to finish before the process exits
+  destroy(): void {
+    this.writer.flushSync();
+    this.changes.removeAllListeners();
+  }
+
+  private update(next: Settings): void {
+    const previous = this.settings;
+    const changed = (Object.keys({ ...previous, ...next }) as (keyof Settings)[]).filter(
+      (key) => JSON.stringify(previous[key]) !== JSON.stringify(next[key])
+    );
+    if (changed.length === 0) {
+      return;
+    }
+
+    this.settings = next;
+    this.writer.schedule();
+    for (const key of changed) {
+      this.changes.emit(key, next[key], previous[key]);
+    }
   }
 }
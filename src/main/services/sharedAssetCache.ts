@@ -0,0 +1,139 @@
+import { Session } from 'electron';
+
+interface CachedAsset {
+  status: number;
+  headers: [string, string][];
+  body: Buffer;
+}
+
+const STATIC_EXTENSIONS = /\.(?:js|mjs|css|png|jpe?g|gif|svg|webp|ico|woff2?|ttf|otf|eot)$/i;
+
+// Static files of the login site fetched once and served to every account webview. Sessions
+// stay separate for cookies and storage; only responses that cannot carry account state are
+// shared: GETs for static file types, answered 200 without Set-Cookie or private/no-store
+// cache directives.
+export class SharedAssetCache {
+  private assets = new Map<string, CachedAsset>(); // Insertion order doubles as LRU order
+  private bytes = 0;
+  private maxBytes: number;
+  private inflight = new Map<string, Promise<CachedAsset | null>>();
+  hits = 0;
+  misses = 0;
+
+  constructor(maxBytes: number = 64 * 1024 * 1024) {
+    this.maxBytes = maxBytes;
+  }
+
+  // Routes the session's https requests through the cache; everything that is not a shareable
+  // static asset goes to the network through the session itself, with its own cookies
+  attach(ses: Session): void {
+    ses.protocol.handle('https', async (request) => {
+      if (!isCacheable(request)) {
+        return ses.fetch(request, { bypassCustomProtocolHandlers: true });
+      }
+
+      const cached = this.lookup(request.url);
+      if (cached) {
+        this.hits++;
+        return toResponse(cached);
+      }
+
+      this.misses++;
+      let pending = this.inflight.get(request.url);
+      if (!pending) {
+        pending = this.fetchAsset(ses, request).finally(() => this.inflight.delete(request.url));
+        this.inflight.set(request.url, pending);
+      }
+      const asset = await pending;
+      return asset ? toResponse(asset) : ses.fetch(request, { bypassCustomProtocolHandlers: true });
+    });
+  }
+
+  clear(): void {
+    this.assets.clear();
+    this.bytes = 0;
+  }
+
+  get size(): number {
+    return this.bytes;
+  }
+
+  private lookup(url: string): CachedAsset | undefined {
+    const asset = this.assets.get(url);
+    if (asset) {
+      // Refresh its LRU position
+      this.assets.delete(url);
+      this.assets.set(url, asset);
+    }
+    return asset;
+  }
+
+  private async fetchAsset(ses: Session, request: Request): Promise<CachedAsset | null> {
+    try {
+      const response = await ses.fetch(request.url, {
+        bypassCustomProtocolHandlers: true,
+        credentials: 'omit', // Shared bytes must not depend on who asked
+      } as RequestInit);
+
+      const cacheControl = response.headers.get('cache-control') || '';
+      if (
+        response.status !== 200 ||
+        response.headers.has('set-cookie') ||
+        /no-store|private/i.test(cacheControl)
+      ) {
+        return null;
+      }
+
+      const asset: CachedAsset = {
+        status: response.status,
+        // The body is already decoded, so the transfer headers no longer describe it
+        headers: Array.from(response.headers.entries()).filter(
+          ([name]) => name !== 'content-encoding' && name !== 'content-length'
+        ),
+        body: Buffer.from(await response.arrayBuffer()),
+      };
+      this.store(request.url, asset);
+      return asset;
+    } catch (error) {
+      console.warn(`🌐 Shared asset fetch failed for ${request.url}:`, error);
+      return null;
+    }
+  }
+
+  private store(url: string, asset: CachedAsset): void {
+    if (asset.body.length > this.maxBytes / 8) {
+      return; // One huge file should not flush everything else
+    }
+
+    const existing = this.assets.get(url);
+    if (existing) {
+      this.assets.delete(url);
+      this.bytes -= existing.body.length;
+    }
+
+    this.assets.set(url, asset);
+    this.bytes += asset.body.length;
+    for (const [oldUrl, old] of this.assets) {
+      if (this.bytes <= this.maxBytes) {
+        break;
+      }
+      this.assets.delete(oldUrl);
+      this.bytes -= old.body.length;
+    }
+  }
+}
+
+function isCacheable(request: Request): boolean {
+  if (request.method !== 'GET' || request.headers.has('range')) {
+    return false;
+  }
+  try {
+    return STATIC_EXTENSIONS.test(new URL(request.url).pathname);
+  } catch {
+    return false;
+  }
+}
+
+function toResponse(asset: CachedAsset): Response {
+  return new Response(asset.body, { status: asset.status, headers: asset.headers });
+}
@@ -0,0 +1,34 @@
+import { performance } from 'perf_hooks';
+import { logger } from './loggingService';
+
+// Milliseconds since process start at which each startup stage was reached. Once every
+// required stage is in, the whole timeline is logged under STARTUP.
+export class StartupProfile {
+  private marks: Record<string, number> = {};
+  private required: string[];
+  private reported = false;
+
+  constructor(required: string[]) {
+    this.required = required;
+  }
+
+  mark(stage: string): void {
+    if (stage in this.marks) {
+      return; // First occurrence only, e.g. a window re-created on macOS activate
+    }
+    this.marks[stage] = Math.round(performance.now());
+    logger.debug(`Startup stage ${stage} at ${this.marks[stage]}ms`, null, 'STARTUP');
+
+    if (!this.reported && this.required.every((required) => required in this.marks)) {
+      this.reported = true;
+      const total = Math.max(...this.required.map((required) => this.marks[required]));
+      logger.info(`Startup finished in ${total}ms`, { ...this.marks }, 'STARTUP');
+    }
+  }
+
+  getMarks(): Record<string, number> {
+    return { ...this.marks };
+  }
+}
+
+export const startupProfile = new StartupProfile(['window-shown', 'accounts-ready']);
@@ -0,0 +1,158 @@
+import { Account, ProcessInfo } from '../../shared/types';
+import type { AccountStorage } from './accountStorage';
+import type { GameProcessManager } from './gameProcessManager';
+
+export type ProcessState = 'up' | 'down' | 'launching';
+
+export interface ProcessDelta {
+  accountId: string;
+  state: ProcessState;
+  processInfo?: ProcessInfo;
+}
+
+// One coalesced main -> renderer update. Account changes cover versions (since, version];
+// resync means the change log no longer reaches back to `since` and the receiver should
+// fetch changes itself instead of receiving a full roster here.
+export interface StateDelta {
+  since: number;
+  version: number;
+  resync: boolean;
+  accounts: Account[];
+  removed: string[];
+  processes: ProcessDelta[];
+}
+
+// Pushes account and process changes to the renderer as they happen, coalescing everything
+// within one frame-sized window into a single message so bursts (bulk imports, launching or
+// closing groups) cost one IPC round instead of one per account
+export class StateDeltaPublisher {
+  private accountStorage: AccountStorage;
+  private processManager: GameProcessManager;
+  private send: (delta: StateDelta) => void;
+  private readonly coalesceMs: number;
+  private sentVersion: number;
+  private pendingProcesses: Map<string, ProcessDelta> = new Map();
+  private accountsDirty = false;
+  private flushTimer: NodeJS.Timeout | null = null;
+  private flushing: Promise<void> | null = null;
+
+  constructor(
+    accountStorage: AccountStorage,
+    processManager: GameProcessManager,
+    send: (delta: StateDelta) => void,
+    coalesceMs = 16
+  ) {
+    this.accountStorage = accountStorage;
+    this.processManager = processManager;
+    this.send = send;
+    this.coalesceMs = coalesceMs;
+    this.sentVersion = accountStorage.getChangeVersion();
+
+    accountStorage.on('change', this.handleAccountChange);
+    processManager.on('status-update', this.handleStatusUpdate);
+    processManager.on('status-update-batch', this.handleStatusBatch);
+  }
+
+  private handleAccountChange = (): void => {
+    this.accountsDirty = true;
+    this.schedule();
+  };
+
+  private handleStatusUpdate = (accountId: string, running: boolean): void => {
+    this.recordProcess(accountId, running);
+    this.schedule();
+  };
+
+  private handleStatusBatch = (updates: Array<{ accountId: string; running: boolean }>): void => {
+    updates.forEach((update) => this.recordProcess(update.accountId, update.running));
+    this.schedule();
+  };
+
+  // Later updates for the same account replace earlier ones within a window
+  private recordProcess(accountId: string, running: boolean): void {
+    if (!running) {
+      this.pendingProcesses.set(accountId, { accountId, state: 'down' });
+      return;
+    }
+
+    const processInfo = this.processManager.getProcessInfo(accountId);
+    this.pendingProcesses.set(accountId, {
+      accountId,
+      state: processInfo?.pid === -2 ? 'launching' : 'up',
+      processInfo: processInfo ? { ...processInfo } : undefined,
+    });
+  }
+
+  private schedule(): void {
+    if (!this.flushTimer) {
+      this.flushTimer = setTimeout(() => {
+        this.flushTimer = null;
+        this.flush().catch((error) => console.error('📤 State delta failed:', error));
+      }, this.coalesceMs);
+    }
+  }
+
+  async flush(): Promise<void> {
+    // Serialize flushes so versions arrive in order
+    while (this.flushing) {
+      await this.flushing;
+    }
+    this.flushing = this.publish();
+    try {
+      await this.flushing;
+    } finally {
+      this.flushing = null;
+    }
+  }
+
+  private async publish(): Promise<void> {
+    const processes = Array.from(this.pendingProcesses.values());
+    this.pendingProcesses.clear();
+
+    const since = this.sentVersion;
+    let delta: StateDelta = {
+      since,
+      version: since,
+      resync: false,
+      accounts: [],
+      removed: [],
+      processes,
+    };
+
+    if (this.accountsDirty) {
+      this.accountsDirty = false;
+      const changes = await this.accountStorage.getAccountChanges(since);
+      delta = changes.full
+        ? { ...delta, version: changes.version, resync: true }
+        : {
+            ...delta,
+            version: changes.version,
+            accounts: changes.accounts,
+            removed: changes.removed,
+          };
+      this.sentVersion = changes.version;
+    }
+
+    if (
+      processes.length === 0 &&
+      delta.accounts.length === 0 &&
+      delta.removed.length === 0 &&
+      !delta.resync
+    ) {
+      return;
+    }
+
+    this.send(delta);
+  }
+
+  destroy(): void {
+    if (this.flushTimer) {
+      clearTimeout(this.flushTimer);
+      this.flushTimer = null;
+    }
+    this.accountStorage.off('change', this.handleAccountChange);
+    this.processManager.off('status-update', this.handleStatusUpdate);
+    this.processManager.off('status-update-batch', this.handleStatusBatch);
+    this.pendingProcesses.clear();
+  }
+}
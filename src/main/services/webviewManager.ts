@@ -1,10 +1,75 @@
-import { BrowserWindow, BrowserView, session } from 'electron';
+import { app, BrowserView, WebContents } from 'electron';
+import * as fs from 'fs/promises';
+import * as path from 'path';
 import { Account } from '../../shared/types';
+import { RingBuffer } from '../../shared/utils/ringBuffer';
 import { mainWindow } from '../main';
+import { PooledWebView, WebViewPool } from './webviewPool';
+import { SharedAssetCache } from './sharedAssetCache';
+import { logger } from './loggingService';
+
+// Field selectors for the Asgard login form, used both to detect it and to fill it
+const USERNAME_SELECTORS = [
+  'input[name="username"]',
+  'input[name="user"]',
+  'input[name="login"]',
+  'input[type="text"][maxlength="20"]',
+  'input[type="text"]',
+  '#username',
+  '#user',
+  '#login',
+];
+const PASSWORD_SELECTORS = [
+  'input[name="password"]',
+  'input[name="pwd"]',
+  'input[type="password"]',
+  '#password',
+  '#pwd',
+];
+const LOGIN_FORM_TIMEOUT_MS = 15000;
+
+interface WebViewBinding {
+  pooled: PooledWebView;
+  autofilled: boolean; // Later page loads (after logging in) only get the control bar
+  detach: () => void; // Removes the account-specific listeners
+}
+
+export interface AutofillResult {
+  accountId: string;
+  login: string;
+  success: boolean;
+  durationMs: number; // From page load to filled form (or giving up)
+  reason?: string;
+  timestamp: number;
+}
+
+export interface AutofillStats {
+  attempts: number;
+  succeeded: number;
+  failed: number;
+  averageMs: number;
+  recent: AutofillResult[];
+}
 
 export class WebViewManager {
   private webViews = new Map<string, BrowserView>();
+  private bindings = new Map<string, WebViewBinding>();
   private loginUrl = 'https://asgard.pw/lk/';
+  private autofillResults = new RingBuffer<AutofillResult>(100);
+  private autofillTotals = { attempts: 0, succeeded: 0, totalMs: 0 };
+  private assetCache: SharedAssetCache | null;
+  private pool: WebViewPool;
+
+  // With sharedAssets the login site's static files are downloaded once for all accounts;
+  // cookies and storage stay per session either way
+  constructor(options: { sharedAssets?: boolean } = {}) {
+    const assetCache = options.sharedAssets === false ? null : new SharedAssetCache();
+    this.assetCache = assetCache;
+    this.pool = new WebViewPool(this.loginUrl, {
+      preload: path.join(__dirname, '..', 'webviewPreload.js'),
+      prepareSession: assetCache ? (ses) => assetCache.attach(ses) : undefined,
+    });
+  }
 
   async openWebViewForAccount(account: Account): Promise<void> {
     try {
@@ -20,6 +85,7 @@ export class WebViewManager {
         } else {
           console.log('WebView exists but is destroyed, removing and creating new one...');
           this.webViews.delete(account.id);
+          this.bindings.delete(account.id);
         }
       }
 
@@ -27,21 +93,10 @@ export class WebViewManager {
         throw new Error('Main window not available');
       }
 
-      const partition = `webview_${account.id}`;
-      const ses = session.fromPartition(partition);
-
-      await ses.clearStorageData();
-
-      const webView = new BrowserView({
-        webPreferences: {
-          partition: partition,
-          nodeIntegration: false,
-          contextIsolation: true,
-          webSecurity: true,
-          allowRunningInsecureContent: false,
-          experimentalFeatures: false,
-        },
-      });
+      // A warm view has already loaded the login page in its own wiped partition
+      const pooled = this.pool.acquire();
+      const webView = pooled.view;
+      const contents = webView.webContents;
 
       mainWindow.setBrowserView(webView);
 
@@ -61,32 +116,7 @@ export class WebViewManager {
 
       this.webViews.set(account.id, webView);
 
-      // Add error handling for webContents
-      webView.webContents.on(
-        'did-fail-load',
-        (event, errorCode, errorDescription, validatedURL) => {
-          console.error(
-            `WebView failed to load: ${errorCode} - ${errorDescription} for URL: ${validatedURL}`
-          );
-        }
-      );
-
-      webView.webContents.on('did-finish-load', () => {
-        console.log('WebView finished loading, attempting to auto-fill credentials...');
-        this.addControlBar(webView, account);
-        this.autoFillCredentials(webView, account);
-      });
-
-      webView.webContents.on('dom-ready', () => {
-        console.log('WebView DOM ready, attempting to auto-fill credentials...');
-        // Add control bar first, then auto-fill
-        this.addControlBar(webView, account);
-        setTimeout(() => {
-          this.autoFillCredentials(webView, account);
-        }, 500);
-      });
-
-      webView.webContents.on('before-input-event', (event, input) => {
+      const onInput = (event: Electron.Event, input: Electron.Input) => {
         if (input.key === 'Escape') {
           this.closeWebView(account.id);
         }
@@ -95,19 +125,51 @@ export class WebViewManager {
           event.preventDefault();
           this.closeWebView(account.id);
         }
-      });
+      };
 
       // Listen for console messages to handle close requests
-      webView.webContents.on('console-message', (event, level, message) => {
+      const onConsoleMessage = (event: Electron.Event, level: number, message: string) => {
         if (message.includes(`WEBVIEW_CLOSE_REQUESTED_${account.id}`)) {
           console.log('Closing WebView via control bar button');
           this.closeWebView(account.id);
         }
-      });
+      };
+
+      const binding: WebViewBinding = {
+        pooled,
+        autofilled: false,
+        detach: () => {
+          contents.off('before-input-event', onInput);
+          contents.off('console-message', onConsoleMessage);
+          contents.off('did-finish-load', onFinishLoad);
+        },
+      };
+
+      // Later navigations (e.g. after logging in) get the control bar again
+      const onFinishLoad = () => {
+        this.addControlBar(webView, account);
+        if (!binding.autofilled) {
+          this.autoFillCredentials(webView, account, binding);
+        }
+      };
 
-      console.log(`Loading URL: ${this.loginUrl}`);
-      await webView.webContents.loadURL(this.loginUrl);
-      console.log('WebView URL load initiated successfully');
+      contents.on('before-input-event', onInput);
+      contents.on('console-message', onConsoleMessage);
+      this.bindings.set(account.id, binding);
+
+      try {
+        await pooled.ready;
+      } catch {
+        console.log(`Preload failed, loading URL: ${this.loginUrl}`);
+        await contents.loadURL(this.loginUrl);
+      }
+
+      if (this.bindings.get(account.id)?.pooled !== pooled || contents.isDestroyed()) {
+        return; // Closed while the page was still loading
+      }
+
+      onFinishLoad();
+      contents.on('did-finish-load', onFinishLoad);
     } catch (error) {
       console.error('Error opening WebView:', error);
       throw error;
@@ -217,35 +279,31 @@ export class WebViewManager {
     }
   }
 
-  private async autoFillCredentials(webView: BrowserView, account: Account): Promise<void> {
+  // Fills the form as soon as the preload reports it on the page. Each attempt is recorded; an
+  // attempt cut short by a navigation is dropped, the next page load starts a new one.
+  private async autoFillCredentials(
+    webView: BrowserView,
+    account: Account,
+    binding: WebViewBinding
+  ): Promise<void> {
+    const started = Date.now();
     try {
-      // Wait a bit for the page to fully load
-      await new Promise((resolve) => setTimeout(resolve, 1000));
+      const formState = await this.waitForLoginForm(webView.webContents);
+      if (formState === 'navigated' || this.bindings.get(account.id) !== binding) {
+        return;
+      }
+      if (formState === 'timeout') {
+        this.recordAutofill(account, false, started, 'Login form did not appear');
+        return;
+      }
 
       const fillScript = `
         (function() {
           try {
             console.log('Auto-fill script running...');
             
-            // Specific selectors for Asgard website
-            const usernameSelectors = [
-              'input[name="username"]',
-              'input[name="user"]',
-              'input[name="login"]',
-              'input[type="text"][maxlength="20"]',
-              'input[type="text"]',
-              '#username',
-              '#user',
-              '#login'
-            ];
-            
-            const passwordSelectors = [
-              'input[name="password"]',
-              'input[name="pwd"]',
-              'input[type="password"]',
-              '#password',
-              '#pwd'
-            ];
+            const usernameSelectors = ${JSON.stringify(USERNAME_SELECTORS)};
+            const passwordSelectors = ${JSON.stringify(PASSWORD_SELECTORS)};
             
             let usernameField = null;
             let passwordField = null;
@@ -276,8 +334,8 @@ export class WebViewManager {
               passwordField.value = '';
               
               // Set new values
-              usernameField.value = '${account.login.replace(/'/g, "\\'")}';
-              passwordField.value = '${account.password.replace(/'/g, "\\'")}';
+              usernameField.value = ${JSON.stringify(account.login)};
+              passwordField.value = ${JSON.stringify(account.password)};
               
               // Trigger events to ensure the website recognizes the changes
               const events = ['input', 'change', 'keyup', 'blur'];
@@ -312,12 +370,82 @@ export class WebViewManager {
       `;
 
       const result = await webView.webContents.executeJavaScript(fillScript);
-      console.log('Auto-fill result:', result);
-    } catch (error) {
+      const filled = result?.filled === true;
+      if (filled) {
+        binding.autofilled = true;
+      }
+      const reason = filled ? undefined : result?.reason || result?.error;
+      this.recordAutofill(account, filled, started, reason);
+    } catch (error: any) {
       console.error('Failed to auto-fill credentials:', error);
+      this.recordAutofill(account, false, started, error.message);
+    }
+  }
+
+  private waitForLoginForm(contents: WebContents): Promise<'ready' | 'timeout' | 'navigated'> {
+    return new Promise((resolve) => {
+      const finish = (state: 'ready' | 'timeout' | 'navigated') => {
+        contents.ipc.off('login-form-state', onFormState);
+        contents.off('did-start-navigation', onNavigation);
+        clearTimeout(guard);
+        resolve(state);
+      };
+      const onFormState = (_event: Electron.IpcMainEvent, state: { ready: boolean }) =>
+        finish(state.ready ? 'ready' : 'timeout');
+      const onNavigation = (
+        _event: Electron.Event,
+        _url: string,
+        isInPlace: boolean,
+        isMainFrame: boolean
+      ) => {
+        if (isMainFrame && !isInPlace) {
+          finish('navigated');
+        }
+      };
+      // In case the page never ran the preload
+      const guard = setTimeout(() => finish('timeout'), LOGIN_FORM_TIMEOUT_MS + 1000);
+
+      contents.ipc.on('login-form-state', onFormState);
+      contents.on('did-start-navigation', onNavigation);
+      contents.send('watch-login-form', {
+        usernameSelectors: USERNAME_SELECTORS,
+        passwordSelectors: PASSWORD_SELECTORS,
+        timeoutMs: LOGIN_FORM_TIMEOUT_MS,
+      });
+    });
+  }
+
+  private recordAutofill(account: Account, success: boolean, started: number, reason?: string) {
+    const result: AutofillResult = {
+      accountId: account.id,
+      login: account.login,
+      success,
+      durationMs: Date.now() - started,
+      reason,
+      timestamp: Date.now(),
+    };
+    this.autofillResults.push(result);
+    this.autofillTotals.attempts++;
+    this.autofillTotals.totalMs += result.durationMs;
+    if (success) {
+      this.autofillTotals.succeeded++;
+      logger.info(`Auto-filled ${account.login} in ${result.durationMs}ms`, null, 'WEBVIEW');
+    } else {
+      logger.warn(`Auto-fill failed for ${account.login}: ${reason}`, result, 'WEBVIEW');
     }
   }
 
+  getAutofillStats(): AutofillStats {
+    const { attempts, succeeded, totalMs } = this.autofillTotals;
+    return {
+      attempts,
+      succeeded,
+      failed: attempts - succeeded,
+      averageMs: attempts > 0 ? Math.round(totalMs / attempts) : 0,
+      recent: this.autofillResults.toArray(),
+    };
+  }
+
   focusWebView(accountId: string): void {
     const webView = this.webViews.get(accountId);
     if (webView && mainWindow) {
@@ -343,6 +471,7 @@ export class WebViewManager {
         console.error('Error focusing WebView:', error);
         // If focusing fails, remove the invalid WebView
         this.webViews.delete(accountId);
+        this.bindings.delete(accountId);
       }
     }
   }
@@ -350,30 +479,35 @@ export class WebViewManager {
   closeWebView(accountId: string): void {
     const webView = this.webViews.get(accountId);
     if (webView && mainWindow) {
+      const binding = this.bindings.get(accountId);
       try {
-        // Remove all event listeners first to prevent memory leaks
-        if (webView.webContents && !webView.webContents.isDestroyed()) {
-          webView.webContents.removeAllListeners();
-          // Close the webContents to free memory
-          webView.webContents.close();
-        }
+        binding?.detach();
 
         // Remove the BrowserView from the main window
         mainWindow.removeBrowserView(webView);
 
         // Remove from our tracking
         this.webViews.delete(accountId);
+        this.bindings.delete(accountId);
 
         // If no more webviews, clear the browser view
         if (this.webViews.size === 0) {
           mainWindow.setBrowserView(null);
         }
 
+        // Wiped and kept warm for the next account, or closed if the pool is full
+        if (binding) {
+          this.pool.release(binding.pooled);
+        } else if (!webView.webContents.isDestroyed()) {
+          webView.webContents.close();
+        }
+
         console.log(`WebView for account ${accountId} closed successfully`);
       } catch (error) {
         console.error('Error closing WebView:', error);
         // Still remove from tracking even if cleanup failed
         this.webViews.delete(accountId);
+        this.bindings.delete(accountId);
       }
     }
   }
@@ -406,9 +540,44 @@ export class WebViewManager {
     }
   }
 
+  // Deletes on-disk webview partitions that no account owns any more. Pooled partitions live in
+  // memory, so anything under Partitions/webview_* was left behind by deleted accounts or by
+  // builds that kept one partition per account.
+  async collectStalePartitions(isLiveAccount: (accountId: string) => boolean): Promise<number> {
+    const partitionsDir = path.join(app.getPath('userData'), 'Partitions');
+    let names: string[];
+    try {
+      names = await fs.readdir(partitionsDir);
+    } catch {
+      return 0; // No partitions on disk
+    }
+
+    let removed = 0;
+    for (const name of names) {
+      const match = /^webview_(.+)$/i.exec(decodeURIComponent(name));
+      if (!match || (!match[1].startsWith('pool_') && isLiveAccount(match[1]))) {
+        continue;
+      }
+      try {
+        await fs.rm(path.join(partitionsDir, name), { recursive: true, force: true });
+        removed++;
+      } catch (error) {
+        console.warn(`🌐 Could not remove stale partition ${name}:`, error);
+      }
+    }
+
+    if (removed > 0) {
+      console.log(`🌐 Removed ${removed} stale webview partitions`);
+    }
+    return removed;
+  }
+
   destroy(): void {
-    // Clean up all webviews and clear memory
+    // Clean up all webviews and clear memory; the pool goes first so closed views are not rewarmed
+    this.pool.destroy();
     this.closeAllWebViews();
     this.webViews.clear();
+    this.bindings.clear();
+    this.assetCache?.clear();
   }
 }
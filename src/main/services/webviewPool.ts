@@ -0,0 +1,170 @@
+import { BrowserView, Session } from 'electron';
+
+export interface PooledWebView {
+  view: BrowserView;
+  partition: string;
+  ready: Promise<void>; // Settles when the login page load started by the pool finishes
+  idleSince: number;
+}
+
+export interface WebViewPoolOptions {
+  maxIdle?: number; // Warm views kept ready for the next open
+  idleTtlMs?: number; // Idle views older than this are closed
+  minFreeMemoryMb?: number; // Below this much free system memory idle views are closed
+  maxCacheMb?: number; // HTTP cache a recycled session may keep; larger caches are cleared
+  prepareSession?: (ses: Session) => void; // Runs once for each new partition
+  preload?: string; // Preload script for every pooled view
+}
+
+// Keeps a few BrowserViews that have already loaded the login page, so opening an account
+// skips the renderer spawn and the cold page load. A view's partition is fixed when it is
+// created, so each pooled view gets its own in-memory partition and is wiped (storage cleared,
+// login page reloaded) before it is handed out again.
+export class WebViewPool {
+  private url: string;
+  private maxIdle: number;
+  private idleTtlMs: number;
+  private minFreeMemoryKb: number;
+  private maxCacheBytes: number;
+  private prepareSession?: (ses: Session) => void;
+  private preload?: string;
+  private idle: PooledWebView[] = [];
+  private nextId = 0;
+  private trimTimer: NodeJS.Timeout | null = null;
+  private destroyed = false;
+
+  constructor(url: string, options: WebViewPoolOptions = {}) {
+    this.url = url;
+    this.maxIdle = options.maxIdle ?? 2;
+    this.idleTtlMs = options.idleTtlMs ?? 5 * 60 * 1000;
+    this.minFreeMemoryKb = (options.minFreeMemoryMb ?? 512) * 1024;
+    this.maxCacheBytes = (options.maxCacheMb ?? 32) * 1024 * 1024;
+    this.prepareSession = options.prepareSession;
+    this.preload = options.preload;
+  }
+
+  // Hands out a warm view when one is idle, otherwise creates one; then tops the pool back up
+  // in the background so the next open in a row is warm too
+  acquire(): PooledWebView {
+    let pooled: PooledWebView | undefined;
+    while ((pooled = this.idle.shift())) {
+      if (!pooled.view.webContents.isDestroyed()) {
+        break;
+      }
+    }
+
+    if (!pooled) {
+      pooled = this.create();
+    }
+
+    setImmediate(() => this.warm());
+    return pooled;
+  }
+
+  // Takes a view back once its account is done with it. It is wiped before reuse, or closed
+  // if the pool is already full or memory is tight.
+  release(pooled: PooledWebView): void {
+    const contents = pooled.view.webContents;
+    if (contents.isDestroyed()) {
+      return;
+    }
+
+    if (this.destroyed || this.idle.length >= this.maxIdle || this.isMemoryLow()) {
+      contents.close();
+      return;
+    }
+
+    // clearStorageData leaves the HTTP cache alone, so the next account still loads from it
+    const ses = contents.session;
+    pooled.ready = ses
+      .clearStorageData()
+      .then(() => ses.getCacheSize())
+      .then((cacheSize) => (cacheSize > this.maxCacheBytes ? ses.clearCache() : undefined))
+      .then(() => contents.loadURL(this.url));
+    pooled.ready.catch((error) => console.warn('🌐 Pooled WebView failed to reload:', error));
+    pooled.idleSince = Date.now();
+    this.idle.push(pooled);
+    this.scheduleTrim();
+  }
+
+  // Fills the pool up to maxIdle unless memory is tight
+  warm(): void {
+    while (!this.destroyed && this.idle.length < this.maxIdle && !this.isMemoryLow()) {
+      this.idle.push(this.create());
+    }
+    this.scheduleTrim();
+  }
+
+  // Closes idle views past their TTL, or all of them under memory pressure
+  trim(): void {
+    const now = Date.now();
+    const memoryLow = this.isMemoryLow();
+    this.idle = this.idle.filter((pooled) => {
+      const keep =
+        !memoryLow &&
+        now - pooled.idleSince < this.idleTtlMs &&
+        !pooled.view.webContents.isDestroyed();
+      if (!keep && !pooled.view.webContents.isDestroyed()) {
+        pooled.view.webContents.close();
+      }
+      return keep;
+    });
+
+    if (this.idle.length === 0 && this.trimTimer) {
+      clearInterval(this.trimTimer);
+      this.trimTimer = null;
+    }
+  }
+
+  get idleCount(): number {
+    return this.idle.length;
+  }
+
+  destroy(): void {
+    this.destroyed = true;
+    this.idleTtlMs = 0;
+    this.trim();
+  }
+
+  private create(): PooledWebView {
+    const partition = `webview_pool_${++this.nextId}`;
+    const view = new BrowserView({
+      webPreferences: {
+        partition: partition,
+        preload: this.preload,
+        nodeIntegration: false,
+        contextIsolation: true,
+        webSecurity: true,
+        allowRunningInsecureContent: false,
+        experimentalFeatures: false,
+      },
+    });
+
+    this.prepareSession?.(view.webContents.session);
+
+    view.webContents.on('did-fail-load', (event, errorCode, errorDescription, validatedURL) => {
+      console.error(
+        `WebView failed to load: ${errorCode} - ${errorDescription} for URL: ${validatedURL}`
+      );
+    });
+
+    const ready = view.webContents.loadURL(this.url);
+    ready.catch((error) => console.warn('🌐 Pooled WebView failed to preload:', error));
+    return { view, partition, ready, idleSince: Date.now() };
+  }
+
+  private isMemoryLow(): boolean {
+    try {
+      return process.getSystemMemoryInfo().free < this.minFreeMemoryKb;
+    } catch {
+      return false;
+    }
+  }
+
+  private scheduleTrim(): void {
+    if (!this.trimTimer && this.idle.length > 0) {
+      this.trimTimer = setInterval(() => this.trim(), 60 * 1000);
+      this.trimTimer.unref();
+    }
+  }
+}
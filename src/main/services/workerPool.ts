@@ -0,0 +1,373 @@
+import { Worker } from 'worker_threads';
+import { existsSync } from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import { metrics } from './performanceMetrics';
+import {
+  runWorkerTask,
+  WorkerTaskInput,
+  WorkerTaskName,
+  WorkerTaskOutput,
+  WorkerTaskProgress,
+} from './workerTasks';
+
+// Messages between the pool and taskWorker.js
+export type WorkerRequest =
+  | { type: 'run'; id: number; task: WorkerTaskName; input: unknown }
+  | { type: 'cancel'; id: number };
+
+export type WorkerResponse =
+  | { type: 'ready' } // Sent once the worker's modules have loaded
+  | { type: 'result'; id: number; result: unknown }
+  | { type: 'error'; id: number; error: { name: string; message: string } }
+  | { type: 'progress'; id: number; progress: unknown };
+
+export interface WorkerRunOptions<P> {
+  signal?: AbortSignal; // Cancels the task, queued or running
+  transfer?: ArrayBuffer[]; // Moved to the worker instead of copied; unusable here afterwards
+  onProgress?: (progress: P) => void;
+}
+
+export interface WorkerPoolOptions {
+  size?: number;
+  script?: string | null; // Worker entry point; null runs every task inline
+  idleTimeout?: number; // Idle workers exit after this long
+}
+
+interface PendingTask {
+  id: number;
+  task: WorkerTaskName;
+  input: unknown;
+  options: WorkerRunOptions<any>;
+  resolve: (result: any) => void;
+  reject: (error: Error) => void;
+  onAbort?: () => void;
+}
+
+interface PoolWorker {
+  worker: Worker;
+  current: PendingTask | null;
+  ready: boolean;
+  idleTimer: NodeJS.Timeout | null;
+  killTimer: NodeJS.Timeout | null;
+}
+
+// Shared worker_threads pool for CPU-heavy jobs (import parsing, export serialization, batch
+// file parsing, log export) so they stop freezing input, IPC and monitoring timers on the
+// main thread. Workers start on demand, run one task each and exit after a while idle. When
+// the compiled worker script is missing (ts-jest) or cannot start, tasks run inline.
+export class WorkerPool {
+  private readonly size: number;
+  private readonly idleTimeout: number;
+  private readonly CANCEL_GRACE = 1000; // Before a cancelled task's worker is terminated
+  private script: string | null;
+  private workers: PoolWorker[] = [];
+  private queue: PendingTask[] = [];
+  private nextId = 1;
+  private destroyed = false;
+  private anyReady = false; // Once a worker has loaded, later failures are crashes, not setup
+
+  constructor(options: WorkerPoolOptions = {}) {
+    this.size = Math.max(1, options.size ?? Math.min(4, os.cpus().length - 1));
+    this.idleTimeout = options.idleTimeout ?? 30000;
+    const script =
+      options.script === undefined
+        ? path.join(__dirname, '..', 'workers', 'taskWorker.js')
+        : options.script;
+    this.script = script && existsSync(script) ? script : null;
+  }
+
+  get inline(): boolean {
+    return this.script === null;
+  }
+
+  run<K extends WorkerTaskName>(
+    task: K,
+    input: WorkerTaskInput<K>,
+    options: WorkerRunOptions<WorkerTaskProgress<K>> = {}
+  ): Promise<WorkerTaskOutput<K>> {
+    if (this.destroyed) {
+      return Promise.reject(new Error('Worker pool has been shut down'));
+    }
+    if (options.signal?.aborted) {
+      return Promise.reject(abortError());
+    }
+
+    const end = metrics.startSpan(`worker.${task}`, { inline: this.inline });
+    if (this.inline) {
+      return this.runInline(task, input, options).finally(() => end());
+    }
+
+    return new Promise<WorkerTaskOutput<K>>((resolve, reject) => {
+      const pending: PendingTask = { id: this.nextId++, task, input, options, resolve, reject };
+      if (options.signal) {
+        pending.onAbort = () => this.cancel(pending);
+        options.signal.addEventListener('abort', pending.onAbort, { once: true });
+      }
+      this.queue.push(pending);
+      this.pump();
+    }).finally(() => end());
+  }
+
+  // Stops every worker; queued and running tasks are rejected
+  async destroy(): Promise<void> {
+    this.destroyed = true;
+    const error = new Error('Worker pool has been shut down');
+    for (const pending of this.queue.splice(0)) {
+      this.settle(pending, error);
+    }
+    await Promise.all(
+      this.workers.map((entry) => {
+        if (entry.current) {
+          this.settle(entry.current, error);
+          entry.current = null;
+        }
+        return this.retire(entry);
+      })
+    );
+  }
+
+  private runInline<K extends WorkerTaskName>(
+    task: K,
+    input: WorkerTaskInput<K>,
+    options: WorkerRunOptions<WorkerTaskProgress<K>>
+  ): Promise<WorkerTaskOutput<K>> {
+    return runWorkerTask(task, input, {
+      signal: options.signal ?? new AbortController().signal,
+      progress: (value) => options.onProgress?.(value),
+    });
+  }
+
+  private pump(): void {
+    while (this.queue.length > 0) {
+      let entry = this.workers.find((candidate) => !candidate.current);
+      if (!entry) {
+        if (this.workers.length >= this.size) {
+          return;
+        }
+        entry = this.spawn();
+        if (!entry) {
+          return;
+        }
+      }
+
+      const pending = this.queue.shift() as PendingTask;
+      if (entry.idleTimer) {
+        clearTimeout(entry.idleTimer);
+        entry.idleTimer = null;
+      }
+      entry.current = pending;
+      try {
+        const request: WorkerRequest = {
+          type: 'run',
+          id: pending.id,
+          task: pending.task,
+          input: pending.input,
+        };
+        entry.worker.postMessage(request, pending.options.transfer ?? []);
+      } catch (error: any) {
+        // Not cloneable; the worker never saw it
+        entry.current = null;
+        this.settle(pending, error);
+        this.markIdle(entry);
+      }
+    }
+  }
+
+  private spawn(): PoolWorker | null {
+    if (!this.script) {
+      return null;
+    }
+
+    let worker: Worker;
+    try {
+      worker = new Worker(this.script);
+    } catch (error) {
+      this.fallBackToInline(error);
+      return null;
+    }
+
+    const entry: PoolWorker = {
+      worker,
+      current: null,
+      ready: false,
+      idleTimer: null,
+      killTimer: null,
+    };
+    worker.on('message', (message: WorkerResponse) => this.handleMessage(entry, message));
+    worker.on('error', (error) => this.handleExit(entry, error));
+    worker.on('exit', (code) => {
+      this.handleExit(entry, new Error(`Worker exited with code ${code}`));
+    });
+    this.workers.push(entry);
+    return entry;
+  }
+
+  private handleMessage(entry: PoolWorker, message: WorkerResponse): void {
+    if (message.type === 'ready') {
+      entry.ready = true;
+      this.anyReady = true;
+      return;
+    }
+
+    const pending = entry.current;
+    if (!pending || pending.id !== message.id) {
+      return; // Late message from a task that was already settled
+    }
+
+    if (message.type === 'progress') {
+      pending.options.onProgress?.(message.progress);
+      return;
+    }
+
+    entry.current = null;
+    if (entry.killTimer) {
+      clearTimeout(entry.killTimer);
+      entry.killTimer = null;
+    }
+    if (message.type === 'result') {
+      this.settle(pending, null, message.result);
+    } else {
+      const error = new Error(message.error.message);
+      error.name = message.error.name;
+      this.settle(pending, error);
+    }
+    this.markIdle(entry);
+    this.pump();
+  }
+
+  // Crash, termination, or a worker that never came up
+  private handleExit(entry: PoolWorker, error: Error): void {
+    const index = this.workers.indexOf(entry);
+    if (index === -1) {
+      return;
+    }
+    this.workers.splice(index, 1);
+    this.clearTimers(entry);
+
+    const pending = entry.current;
+    entry.current = null;
+    if (this.destroyed) {
+      return;
+    }
+
+    const cancelled = pending?.options.signal?.aborted === true;
+    if (!entry.ready && !this.anyReady && !cancelled) {
+      // The script itself cannot run here. Its task goes inline with the rest of the queue,
+      // unless its input was transferred away.
+      if (pending && !pending.options.transfer?.length) {
+        this.queue.unshift(pending);
+      } else if (pending) {
+        this.settle(pending, error);
+      }
+      this.fallBackToInline(error);
+      return;
+    }
+    if (pending) {
+      this.settle(pending, cancelled ? abortError() : error);
+    }
+    this.pump();
+  }
+
+  private fallBackToInline(error: unknown): void {
+    if (this.script) {
+      console.warn('🧵 Worker threads unavailable, running jobs inline:', error);
+      this.script = null;
+    }
+
+    for (const pending of this.queue.splice(0)) {
+      this.detachAbort(pending);
+      this.runInline(pending.task, pending.input as never, pending.options).then(
+        pending.resolve,
+        pending.reject
+      );
+    }
+  }
+
+  private cancel(pending: PendingTask): void {
+    const queued = this.queue.indexOf(pending);
+    if (queued !== -1) {
+      this.queue.splice(queued, 1);
+      this.settle(pending, abortError());
+      return;
+    }
+
+    const entry = this.workers.find((candidate) => candidate.current === pending);
+    if (!entry) {
+      return;
+    }
+    const request: WorkerRequest = { type: 'cancel', id: pending.id };
+    entry.worker.postMessage(request);
+    // Tasks check for cancellation between chunks; one stuck in a tight loop loses its worker
+    entry.killTimer = setTimeout(() => {
+      void entry.worker.terminate();
+    }, this.CANCEL_GRACE);
+  }
+
+  private settle(pending: PendingTask, error: Error | null, result?: unknown): void {
+    this.detachAbort(pending);
+    if (error) {
+      pending.reject(error);
+    } else {
+      pending.resolve(result);
+    }
+  }
+
+  private detachAbort(pending: PendingTask): void {
+    if (pending.onAbort) {
+      pending.options.signal?.removeEventListener('abort', pending.onAbort);
+      pending.onAbort = undefined;
+    }
+  }
+
+  private markIdle(entry: PoolWorker): void {
+    entry.idleTimer = setTimeout(() => {
+      entry.idleTimer = null;
+      if (!entry.current) {
+        void this.retire(entry);
+      }
+    }, this.idleTimeout);
+    entry.idleTimer.unref();
+  }
+
+  private async retire(entry: PoolWorker): Promise<void> {
+    const index = this.workers.indexOf(entry);
+    if (index !== -1) {
+      this.workers.splice(index, 1);
+    }
+    this.clearTimers(entry);
+    await entry.worker.terminate();
+  }
+
+  private clearTimers(entry: PoolWorker): void {
+    if (entry.idleTimer) {
+      clearTimeout(entry.idleTimer);
+      entry.idleTimer = null;
+    }
+    if (entry.killTimer) {
+      clearTimeout(entry.killTimer);
+      entry.killTimer = null;
+    }
+  }
+}
+
+// A copy of `bytes` whose buffer can be transferred, or its own buffer when it already spans
+// exactly these bytes (Buffers from small reads can be views into a shared pool)
+export function transferableBytes(bytes: Uint8Array): Uint8Array {
+  if (
+    bytes.byteOffset === 0 &&
+    bytes.byteLength === bytes.buffer.byteLength &&
+    bytes.buffer instanceof ArrayBuffer
+  ) {
+    return bytes;
+  }
+  return new Uint8Array(bytes);
+}
+
+function abortError(): Error {
+  const error = new Error('The operation was aborted');
+  error.name = 'AbortError';
+  return error;
+}
+
+export const workerPool = new WorkerPool();
@@ -0,0 +1,134 @@
+import { createReadStream, createWriteStream } from 'fs';
+import { once } from 'events';
+import * as readline from 'readline';
+import { Account } from '../../shared/types';
+import {
+  AccountFileChunk,
+  ImportProgress,
+  normalizeImportedAccount,
+  readAccountFile,
+  writeAccountFile,
+} from './accountFileStream';
+import { decodeBatchFile, parseBatchContent } from './batchFileFormat';
+import { formatLogEntry, LogFilter, matchesLogFilter, parseStructuredLine } from './logFormat';
+
+// Every job the worker pool can run: what goes in, what comes back and what progress it
+// reports. Inputs and outputs cross a thread boundary, so they must be structured-cloneable.
+export interface WorkerTaskMap {
+  parseAccountFile: {
+    input: { filePath: string; format: 'json' | 'csv' };
+    output: Partial<Account>[];
+    progress: ImportProgress;
+  };
+  writeAccountFile: {
+    input: {
+      filePath: string;
+      accounts: Account[];
+      format: 'json' | 'csv';
+      chunk?: AccountFileChunk; // One slice of a larger export
+    };
+    output: void;
+    progress: never;
+  };
+  parseBatchFile: {
+    input: { bytes: Uint8Array };
+    output: Partial<Account>;
+    progress: never;
+  };
+  exportLogs: {
+    input: { outputPath: string; sources: string[]; filter?: LogFilter };
+    output: number; // Entries written
+    progress: never;
+  };
+}
+
+export type WorkerTaskName = keyof WorkerTaskMap;
+export type WorkerTaskInput<K extends WorkerTaskName> = WorkerTaskMap[K]['input'];
+export type WorkerTaskOutput<K extends WorkerTaskName> = WorkerTaskMap[K]['output'];
+export type WorkerTaskProgress<K extends WorkerTaskName> = WorkerTaskMap[K]['progress'];
+
+export interface WorkerTaskContext<P> {
+  signal: AbortSignal; // Aborted when the caller cancels; long tasks check it between chunks
+  progress: (value: P) => void;
+}
+
+type WorkerTaskHandlers = {
+  [K in WorkerTaskName]: (
+    input: WorkerTaskInput<K>,
+    context: WorkerTaskContext<WorkerTaskProgress<K>>
+  ) => WorkerTaskOutput<K> | Promise<WorkerTaskOutput<K>>;
+};
+
+const handlers: WorkerTaskHandlers = {
+  async parseAccountFile({ filePath, format }, { signal, progress }) {
+    const accounts: Partial<Account>[] = [];
+    await readAccountFile(
+      filePath,
+      format,
+      (account) => {
+        accounts.push(format === 'json' ? normalizeImportedAccount(account) : account);
+      },
+      progress,
+      signal
+    );
+    return accounts;
+  },
+
+  async writeAccountFile({ filePath, accounts, format, chunk }, { signal }) {
+    await writeAccountFile(filePath, accounts, format, signal, chunk);
+  },
+
+  parseBatchFile({ bytes }) {
+    // One decode, one pass over the text
+    const { text } = decodeBatchFile(bytes);
+    return parseBatchContent(text);
+  },
+
+  async exportLogs({ outputPath, sources, filter }, { signal }) {
+    const output = createWriteStream(outputPath, { encoding: 'utf8' });
+    const failed = once(output, 'error').then(([error]) => Promise.reject(error));
+    failed.catch(() => undefined);
+    const write = async (text: string) => {
+      if (!output.write(text)) {
+        await Promise.race([once(output, 'drain'), failed]);
+      }
+    };
+
+    let written = 0;
+    try {
+      for (const source of sources) {
+        const lines = readline.createInterface({
+          input: createReadStream(source, { encoding: 'utf8' }),
+          crlfDelay: Infinity,
+        });
+        for await (const line of lines) {
+          signal.throwIfAborted();
+          const entry = parseStructuredLine(line);
+          if (entry && (!filter || matchesLogFilter(entry, filter))) {
+            await write((written === 0 ? '' : '\n') + formatLogEntry(entry));
+            written++;
+          }
+        }
+      }
+
+      output.end();
+      await Promise.race([once(output, 'finish'), failed]);
+    } catch (error) {
+      output.destroy();
+      throw error;
+    }
+    return written;
+  },
+};
+
+export function runWorkerTask<K extends WorkerTaskName>(
+  task: K,
+  input: WorkerTaskInput<K>,
+  context: WorkerTaskContext<WorkerTaskProgress<K>>
+): Promise<WorkerTaskOutput<K>> {
+  const handler = handlers[task] as WorkerTaskHandlers[K] | undefined;
+  if (!handler) {
+    return Promise.reject(new Error(`Unknown worker task: ${String(task)}`));
+  }
+  return Promise.resolve().then(() => handler(input, context));
+}
@@ -0,0 +1,47 @@
+import { ipcRenderer } from 'electron';
+
+interface WatchLoginFormRequest {
+  usernameSelectors: string[];
+  passwordSelectors: string[];
+  timeoutMs: number;
+}
+
+// Preload for the account login webviews. When the main process asks, it watches the page
+// with a MutationObserver and answers as soon as visible login fields exist, so autofill runs
+// the moment the form renders instead of after a fixed delay.
+ipcRenderer.on('watch-login-form', (_event, request: WatchLoginFormRequest) => {
+  const findVisible = (selectors: string[]) =>
+    selectors.some((selector) => {
+      const field = document.querySelector<HTMLElement>(selector);
+      return !!field && field.offsetParent !== null;
+    });
+  const formReady = () =>
+    findVisible(request.usernameSelectors) && findVisible(request.passwordSelectors);
+
+  let observer: MutationObserver | null = null;
+  let timer: ReturnType<typeof setTimeout> | null = null;
+  const finish = (ready: boolean) => {
+    observer?.disconnect();
+    if (timer) clearTimeout(timer);
+    ipcRenderer.send('login-form-state', { ready });
+  };
+
+  if (formReady()) {
+    finish(true);
+    return;
+  }
+
+  // Visibility often flips through class or style changes rather than new nodes
+  observer = new MutationObserver(() => {
+    if (formReady()) {
+      finish(true);
+    }
+  });
+  observer.observe(document.documentElement, {
+    childList: true,
+    subtree: true,
+    attributes: true,
+    attributeFilter: ['class', 'style', 'hidden'],
+  });
+  timer = setTimeout(() => finish(false), request.timeoutMs);
+});
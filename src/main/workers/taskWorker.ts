@@ -0,0 +1,41 @@
+import { parentPort } from 'worker_threads';
+import type { WorkerRequest, WorkerResponse } from '../services/workerPool';
+import { runWorkerTask } from '../services/workerTasks';
+
+// Entry point of the WorkerPool threads: runs one task at a time from the pool's queue and
+// answers with its result, progress updates or error. Cancelling aborts the task's signal.
+const port = parentPort;
+if (!port) {
+  throw new Error('taskWorker must run as a worker thread');
+}
+
+const controllers = new Map<number, AbortController>();
+const send = (message: WorkerResponse) => port.postMessage(message);
+
+port.on('message', async (request: WorkerRequest) => {
+  if (request.type === 'cancel') {
+    controllers.get(request.id)?.abort();
+    return;
+  }
+
+  const { id, task, input } = request;
+  const controller = new AbortController();
+  controllers.set(id, controller);
+  try {
+    const result = await runWorkerTask(task, input as never, {
+      signal: controller.signal,
+      progress: (progress) => send({ type: 'progress', id, progress }),
+    });
+    send({ type: 'result', id, result });
+  } catch (error: any) {
+    send({
+      type: 'error',
+      id,
+      error: { name: error?.name || 'Error', message: error?.message || String(error) },
+    });
+  } finally {
+    controllers.delete(id);
+  }
+});
+
+send({ type: 'ready' });
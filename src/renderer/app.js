@@ -2,6 +2,7 @@
 class PerfectWorldAccountManager {
   constructor() {
     this.accounts = [];
+    this.accountsVersion = 0; // Last account change version received from main
     this.settings = null;
     this.selectedAccountIds = new Set();
     this.runningProcesses = new Map(); // Map accountId -> processInfo
@@ -10,11 +11,36 @@ class PerfectWorldAccountManager {
     this.activeTab = 'general'; // For settings dialog tabs
     this.operationTimer = null; // Timer for status bar auto-clear
     
+    // Account table view model: rows are rendered from accountView, never read from the DOM
+    this.accountsById = new Map();
+    this.accountView = [];
+    this.filterText = '';
+    this.sortKey = null;
+    this.sortDirection = 1;
+    this.rowCache = new Map(); // accountId -> { row, account }
+    this.clientResources = {}; // accountId -> { cpuPercent, workingSetBytes } from process-resources
+    this.rowHeight = 41; // Re-measured from the first rendered row
+    this.renderedRange = { first: -1, last: -1 };
+    this.pendingDeltas = []; // state-delta messages waiting for the next animation frame
+    this.deltaFrame = null;
+    
+    // Log panel view model: logView is the filtered list (newest first) from query-logs
+    this.logView = [];
+    this.logFilter = {};
+    this.logQueryId = 0;
+    this.logSearchTimer = null;
+    this.pendingLogEntries = []; // Live entries waiting for the next animation frame
+    this.logFrame = null;
+    this.expandedLogIds = new Set();
+    this.logHeights = new Map(); // Measured heights of expanded entries
+    this.logRowHeight = 34; // Re-measured from rendered entries
+    
     this.initialize();
   }
 
   async initialize() {
     await this.loadSettings();
+    await this.loadRosterSnapshot();
     await this.loadAccounts();
     await this.loadRunningProcesses();
     this.setupEventListeners();
@@ -30,13 +56,120 @@ class PerfectWorldAccountManager {
     }
   }
 
+  // Paints the last known roster while main is still reading the accounts file. The rows are
+  // inert until loadAccounts replaces them (the cache holds no passwords).
+  async loadRosterSnapshot() {
+    try {
+      const roster = await window.electronAPI.invoke('get-roster-snapshot');
+      if (roster && roster.length > 0) {
+        this.applyAccountChanges({ version: 0, full: true, accounts: roster, removed: [] });
+        document.getElementById('account-tbody')?.classList.add('roster-preview');
+        this.renderAccountTable();
+      }
+    } catch (error) {
+      console.error('Failed to load roster snapshot:', error);
+    }
+  }
+
   async loadAccounts() {
     try {
-      this.accounts = await window.electronAPI.invoke('get-accounts');
+      // Only accounts changed since the last load are sent; the first call gets the full list
+      const changes = await window.electronAPI.invoke('get-account-changes', this.accountsVersion);
+      this.applyAccountChanges(changes);
+      document.getElementById('account-tbody')?.classList.remove('roster-preview');
       this.renderAccountTable();
     } catch (error) {
       console.error('Failed to load accounts:', error);
       this.accounts = [];
+      this.accountsVersion = 0;
+      document.getElementById('account-tbody')?.classList.remove('roster-preview');
+    }
+  }
+  
+  applyAccountChanges(changes) {
+    this.accountsVersion = changes.version;
+    
+    if (changes.full) {
+      this.accounts = changes.accounts;
+      return;
+    }
+    
+    if (changes.accounts.length === 0 && changes.removed.length === 0) {
+      return;
+    }
+    
+    const removed = new Set(changes.removed);
+    const changed = new Map(changes.accounts.map(a => [a.id, a]));
+    
+    // Replace in place to keep table order; running state lives only in the renderer
+    const merged = [];
+    for (const account of this.accounts) {
+      if (removed.has(account.id)) continue;
+      
+      const update = changed.get(account.id);
+      if (update) {
+        merged.push({ ...update, isRunning: account.isRunning });
+        changed.delete(account.id);
+      } else {
+        merged.push(account);
+      }
+    }
+    
+    // Whatever is left is new
+    merged.push(...changed.values());
+    this.accounts = merged;
+  }
+
+  applyPendingDeltas() {
+    this.deltaFrame = null;
+    const deltas = this.pendingDeltas;
+    this.pendingDeltas = [];
+    
+    let needsResync = false;
+    let accountsChanged = false;
+    const touched = new Set();
+    
+    for (const delta of deltas) {
+      if (delta.resync || delta.since > this.accountsVersion) {
+        // Missed versions in between - fetch our own delta below
+        needsResync = true;
+      } else if (delta.version > this.accountsVersion) {
+        // Records carry the latest state, so a range overlapping what we have applies cleanly
+        this.applyAccountChanges({
+          version: delta.version,
+          full: false,
+          accounts: delta.accounts,
+          removed: delta.removed,
+        });
+        accountsChanged = accountsChanged || delta.accounts.length > 0 || delta.removed.length > 0;
+        delta.removed.forEach(id => this.selectedAccountIds.delete(id));
+      }
+      
+      for (const update of delta.processes) {
+        const account = this.getAccount(update.accountId);
+        if (account) {
+          account.isRunning = update.state !== 'down';
+        }
+        if (update.state === 'down') {
+          this.runningProcesses.delete(update.accountId);
+        } else if (update.processInfo) {
+          this.runningProcesses.set(update.accountId, update.processInfo);
+        }
+        touched.add(update.accountId);
+      }
+    }
+    
+    if (accountsChanged || (touched.size > 0 && this.sortKey === 'status')) {
+      this.renderAccountTable();
+      this.updateUI();
+    } else {
+      touched.forEach(accountId => this.updateAccountRow(accountId));
+      this.updateStatusBar();
+      this.updateToolbarButtons();
+    }
+    
+    if (needsResync) {
+      this.loadAccounts().then(() => this.updateUI());
     }
   }
 
@@ -49,9 +182,10 @@ class PerfectWorldAccountManager {
         this.runningProcesses.set(processInfo.accountId, processInfo);
         
         // Update account running status
-        const account = this.accounts.find(a => a.id === processInfo.accountId);
+        const account = this.getAccount(processInfo.accountId);
         if (account) {
           account.isRunning = true;
+          this.updateAccountRow(account.id);
         }
       }
     } catch (error) {
@@ -92,28 +226,50 @@ class PerfectWorldAccountManager {
       e.preventDefault();
       this.showSettingsDialog('logs');
     });
+    
+    document.getElementById('cancel-launch')?.addEventListener('click', async (e) => {
+      e.preventDefault();
+      await window.electronAPI.invoke('cancel-launch');
+    });
+    
+    document.getElementById('cancel-scan')?.addEventListener('click', async (e) => {
+      e.preventDefault();
+      await window.electronAPI.invoke('cancel-scan');
+    });
+    
+    this.setupTableEventListeners();
 
     // IPC listeners
-    window.electronAPI.on('process-status-update', (_, data) => {
-      console.log(`📥 Received status update:`, data);
-      const account = this.accounts.find(a => a.id === data.accountId);
-      if (account) {
-        account.isRunning = data.running;
-        
-        // Update process information
-        if (data.running && data.processInfo) {
-          console.log(`📥 Updating process info for ${data.accountId}: PID ${data.processInfo.pid}`);
-          this.runningProcesses.set(data.accountId, data.processInfo);
-        } else {
-          this.runningProcesses.delete(data.accountId);
-        }
-        
-        this.renderAccountTable();
-        this.updateStatusBar();
-        this.updateToolbarButtons(); // Update toolbar buttons after status change
+    // Main pushes coalesced account/process deltas; they are applied once per frame
+    window.electronAPI.on('state-delta', (_, delta) => {
+      this.pendingDeltas.push(delta);
+      if (!this.deltaFrame) {
+        this.deltaFrame = requestAnimationFrame(() => this.applyPendingDeltas());
+      }
+    });
+    
+    window.electronAPI.on('scan-progress', (_, progress) => {
+      this.updateScanProgress(progress);
+    });
+    
+    window.electronAPI.on('import-progress', (_, progress) => {
+      this.updateImportProgress(progress);
+    });
+    
+    // Launch and close jobs stream coalesced progress (at most one message per frame per job)
+    window.electronAPI.on('job-progress', (_, progress) => {
+      if (progress.operation === 'launch') {
+        this.updateLaunchProgress(progress);
+      } else if (progress.operation === 'close' && progress.state !== 'running') {
+        const failedText = progress.failed > 0 ? `, ${progress.failed} failed` : '';
+        this.showToast(`Closed ${progress.done} of ${progress.total} clients${failedText}`);
       }
     });
     
+    window.electronAPI.on('process-resources', (_, resources) => {
+      this.updateClientResources(resources);
+    });
+    
     // Logging event listeners
     window.electronAPI.on('log-added', (_, logEntry) => {
       this.logs.push(logEntry);
@@ -145,9 +301,14 @@ class PerfectWorldAccountManager {
       this.recentErrors = [];
       this.updateErrorIndicator();
       
+      this.logView = [];
+      this.pendingLogEntries = [];
+      this.expandedLogIds.clear();
+      this.logHeights.clear();
+      
       // Update logs view if it's open
       if (this.activeTab === 'logs' && document.querySelector('.logs-container')) {
-        this.renderLogs();
+        this.renderVisibleLogs();
       }
     });
   }
@@ -191,6 +352,59 @@ class PerfectWorldAccountManager {
     }
   }
 
+  updateLaunchProgress(progress) {
+    const container = document.getElementById('launch-progress');
+    const text = document.getElementById('launch-progress-text');
+    if (!container || !text) return;
+    
+    if (progress.state !== 'running') {
+      container.style.display = 'none';
+      const failedText = progress.failed > 0 ? `, ${progress.failed} failed` : '';
+      if (progress.state === 'cancelled') {
+        this.showToast(`Group launch cancelled after ${progress.done} of ${progress.total} clients${failedText}`);
+      } else {
+        this.showToast(`Group launch finished: ${progress.done} of ${progress.total} clients${failedText}`);
+      }
+      return;
+    }
+    
+    const starting = progress.active.length > 0 ? ` - starting ${progress.active.join(', ')}` : '';
+    const waiting = progress.throttled ? ` - waiting for free ${progress.throttled === 'cpu' ? 'CPU' : 'memory'}` : '';
+    text.textContent = `Launched ${progress.done}/${progress.total}${starting}${waiting}`;
+    container.style.display = 'flex';
+  }
+  
+  updateScanProgress(progress) {
+    const container = document.getElementById('scan-progress');
+    const text = document.getElementById('scan-progress-text');
+    if (!container || !text) return;
+    
+    if (progress.done) {
+      container.style.display = 'none';
+      return;
+    }
+    
+    text.textContent = `Scanning: ${progress.found} found in ${progress.directoriesScanned} folders`;
+    container.style.display = 'flex';
+  }
+  
+  updateImportProgress(progress) {
+    const container = document.getElementById('import-progress');
+    const text = document.getElementById('import-progress-text');
+    if (!container || !text) return;
+    
+    if (progress.done) {
+      container.style.display = 'none';
+      return;
+    }
+    
+    const percent = progress.totalBytes > 0
+      ? Math.round((progress.bytesRead / progress.totalBytes) * 100)
+      : 0;
+    text.textContent = `Reading import: ${percent}% (${progress.accounts} accounts)`;
+    container.style.display = 'flex';
+  }
+  
   getSelectedRunningAccounts() {
     return this.accounts.filter(account => 
       this.selectedAccountIds.has(account.id) && account.isRunning
@@ -210,119 +424,293 @@ class PerfectWorldAccountManager {
     return 'Running';
   }
 
+  // Rebuilds the view model (filter + sort over this.accounts) and redraws the visible rows
   renderAccountTable() {
-    const tbody = document.getElementById('account-tbody');
-    if (!tbody) return;
+    const started = performance.now();
+    this.rebuildAccountView();
+    this.renderVisibleRows(true);
+    window.electronAPI.reportTiming?.('renderer.renderAccountTable', performance.now() - started);
+  }
 
-    tbody.innerHTML = '';
+  rebuildAccountView() {
+    this.accountsById = new Map(this.accounts.map(a => [a.id, a]));
+    
+    const filter = this.filterText.trim().toLowerCase();
+    let view = filter
+      ? this.accounts.filter(account =>
+          ['login', 'server', 'characterName', 'description', 'owner'].some(key =>
+            (account[key] || '').toLowerCase().includes(filter)
+          )
+        )
+      : this.accounts.slice();
+    
+    if (this.sortKey) {
+      const key = this.sortKey;
+      const direction = this.sortDirection;
+      const value = key === 'status'
+        ? (account) => (account.isRunning ? 1 : 0)
+        : (account) => (account[key] || '').toLowerCase();
+      view.sort((a, b) => {
+        const va = value(a);
+        const vb = value(b);
+        return va < vb ? -direction : va > vb ? direction : 0;
+      });
+    }
+    
+    this.accountView = view;
+    
+    // Rows for accounts that no longer exist can be dropped
+    for (const id of this.rowCache.keys()) {
+      if (!this.accountsById.has(id)) this.rowCache.delete(id);
+    }
+  }
+  
+  getAccount(accountId) {
+    return this.accountsById.get(accountId) || this.accounts.find(a => a.id === accountId);
+  }
 
-    this.accounts.forEach(account => {
-      const row = document.createElement('tr');
-      row.dataset.accountId = account.id;
-      
-      const isSelected = this.selectedAccountIds.has(account.id);
-      const isRunning = account.isRunning || false;
-      
-      if (isSelected) row.classList.add('selected');
-      if (isRunning) row.classList.add('running');
-      
-      row.innerHTML = `
-        <td>
-          <input type="checkbox" ${isSelected ? 'checked' : ''} data-account-id="${account.id}">
-        </td>
-        <td class="login-cell" title="Click to copy">${this.escapeHtml(account.login)}</td>
-        <td class="password-cell" title="Click to copy">••••••••</td>
-        <td>${this.escapeHtml(account.server)}</td>
-        <td>${this.escapeHtml(account.characterName || '')}</td>
-        <td>${this.escapeHtml(account.description || '')}</td>
-        <td>${this.escapeHtml(account.owner || '')}</td>
-        <td>
-          <span class="status-indicator ${isRunning ? 'running' : 'stopped'}">
-            ${isRunning ? this.getRunningStatusText(account.id) : 'Stopped'}
-          </span>
-        </td>
-        <td>
-          <div class="action-buttons">
-            <button class="action-btn play" ${isRunning ? 'disabled' : ''} title="Launch">▶</button>
-            <button class="action-btn close" ${!isRunning ? 'disabled' : ''} title="Close">⏹</button>
-            <button class="action-btn webview" title="Open WebView">🌐</button>
-          </div>
-        </td>
-      `;
-      
-      this.setupRowEventListeners(row, account);
-      tbody.appendChild(row);
-    });
+  // Only rows inside the scrolled viewport (plus a margin) are in the DOM; spacer rows keep
+  // the scrollbar sized for the full list
+  renderVisibleRows(force = false) {
+    const tbody = document.getElementById('account-tbody');
+    const container = document.getElementById('account-table-container');
+    if (!tbody || !container) return;
+    
+    const total = this.accountView.length;
+    const rowHeight = this.rowHeight;
+    const overscan = 10;
+    const first = Math.max(0, Math.floor(container.scrollTop / rowHeight) - overscan);
+    const visibleCount = Math.ceil((container.clientHeight || 600) / rowHeight) + overscan * 2;
+    const last = Math.min(total, first + visibleCount);
+    
+    if (!force && first === this.renderedRange.first && last === this.renderedRange.last) {
+      return;
+    }
+    this.renderedRange = { first, last };
+    
+    const fragment = document.createDocumentFragment();
+    fragment.appendChild(this.createSpacerRow(first * rowHeight));
+    for (let i = first; i < last; i++) {
+      fragment.appendChild(this.getAccountRow(this.accountView[i]));
+    }
+    fragment.appendChild(this.createSpacerRow((total - last) * rowHeight));
+    tbody.replaceChildren(fragment);
+    
+    // Measure once real rows exist so spacers match the stylesheet
+    const sample = tbody.querySelector('tr[data-account-id]');
+    if (sample && sample.offsetHeight > 0 && sample.offsetHeight !== rowHeight) {
+      this.rowHeight = sample.offsetHeight;
+      this.renderVisibleRows(true);
+    }
+  }
+  
+  createSpacerRow(height) {
+    const row = document.createElement('tr');
+    row.className = 'spacer-row';
+    row.innerHTML = `<td colspan="10" style="height: ${height}px; padding: 0; border: none;"></td>`;
+    return row;
+  }
+  
+  // Rows are cached per account object; a new object from main (after a save) rebuilds it
+  getAccountRow(account) {
+    const cached = this.rowCache.get(account.id);
+    if (cached && cached.account === account) {
+      this.patchAccountRow(cached.row, account);
+      return cached.row;
+    }
+    
+    const row = this.createAccountRow(account);
+    this.rowCache.set(account.id, { row, account });
+    return row;
+  }
+  
+  createAccountRow(account) {
+    const row = document.createElement('tr');
+    row.dataset.accountId = account.id;
+    
+    row.innerHTML = `
+      <td>
+        <input type="checkbox" data-account-id="${account.id}">
+      </td>
+      <td class="login-cell" title="Click to copy">${this.escapeHtml(account.login)}</td>
+      <td class="password-cell" title="Click to copy">••••••••</td>
+      <td>${this.escapeHtml(account.server)}</td>
+      <td>${this.escapeHtml(account.characterName || '')}</td>
+      <td>${this.escapeHtml(account.description || '')}</td>
+      <td>${this.escapeHtml(account.owner || '')}</td>
+      <td>
+        <span class="status-indicator"></span>
+      </td>
+      <td class="resources-cell"></td>
+      <td>
+        <div class="action-buttons">
+          <button class="action-btn play" title="Launch">▶</button>
+          <button class="action-btn close" title="Close">⏹</button>
+          <button class="action-btn webview" title="Open WebView">🌐</button>
+        </div>
+      </td>
+    `;
+    
+    this.patchAccountRow(row, account);
+    return row;
+  }
+  
+  // Applies selection and running state to an existing row without touching the rest
+  patchAccountRow(row, account) {
+    const isSelected = this.selectedAccountIds.has(account.id);
+    const isRunning = account.isRunning || false;
+    
+    row.classList.toggle('selected', isSelected);
+    row.classList.toggle('running', isRunning);
+    row.querySelector('input[type="checkbox"]').checked = isSelected;
+    
+    const status = row.querySelector('.status-indicator');
+    status.className = `status-indicator ${isRunning ? 'running' : 'stopped'}`;
+    status.textContent = isRunning ? this.getRunningStatusText(account.id) : 'Stopped';
+    
+    row.querySelector('.action-btn.play').disabled = isRunning;
+    row.querySelector('.action-btn.close').disabled = !isRunning;
+    
+    const usage = isRunning ? this.clientResources[account.id] : null;
+    row.querySelector('.resources-cell').textContent = usage
+      ? `${Math.round(usage.cpuPercent)}% · ${Math.round(usage.workingSetBytes / (1024 * 1024))} MB`
+      : '';
+  }
+  
+  // Resource samples arrive every few seconds while clients run; only rendered rows are touched
+  updateClientResources(resources) {
+    const changed = new Set([...Object.keys(this.clientResources), ...Object.keys(resources)]);
+    this.clientResources = resources;
+    for (const accountId of changed) {
+      const account = this.getAccount(accountId);
+      const cached = this.rowCache.get(accountId);
+      if (account && cached && cached.row.isConnected) {
+        this.patchAccountRow(cached.row, cached.account);
+      }
+    }
+  }
+  
+  // Patches one account's row if it is currently rendered
+  updateAccountRow(accountId) {
+    const account = this.getAccount(accountId);
+    const cached = this.rowCache.get(accountId);
+    if (account && cached && cached.row.isConnected) {
+      if (cached.account === account) {
+        this.patchAccountRow(cached.row, account);
+      } else {
+        const row = this.createAccountRow(account);
+        cached.row.replaceWith(row);
+        this.rowCache.set(accountId, { row, account });
+      }
+    }
+    
+    // A status change can move the row when sorting by status
+    if (this.sortKey === 'status') {
+      this.renderAccountTable();
+    }
   }
 
-  setupRowEventListeners(row, account) {
-    const checkbox = row.querySelector('input[type="checkbox"]');
-    checkbox?.addEventListener('change', (e) => {
-      const checked = e.target.checked;
-      if (checked) {
+  // One set of listeners on the table body serves every row, rendered now or later
+  setupTableEventListeners() {
+    const tbody = document.getElementById('account-tbody');
+    const container = document.getElementById('account-table-container');
+    if (!tbody || !container) return;
+    
+    let scrollFrame = null;
+    container.addEventListener('scroll', () => {
+      if (scrollFrame) return;
+      scrollFrame = requestAnimationFrame(() => {
+        scrollFrame = null;
+        this.renderVisibleRows();
+      });
+    });
+    window.addEventListener('resize', () => this.renderVisibleRows(true));
+    
+    const accountFromEvent = (e) => {
+      const row = e.target.closest('tr[data-account-id]');
+      return row ? this.getAccount(row.dataset.accountId) : null;
+    };
+    
+    tbody.addEventListener('change', (e) => {
+      if (!e.target.matches('input[type="checkbox"]')) return;
+      const account = accountFromEvent(e);
+      if (!account) return;
+      
+      if (e.target.checked) {
         this.selectedAccountIds.add(account.id);
-        row.classList.add('selected');
       } else {
         this.selectedAccountIds.delete(account.id);
-        row.classList.remove('selected');
       }
+      this.updateAccountRow(account.id);
       this.updateToolbarButtons();
     });
     
-    const loginCell = row.querySelector('.login-cell');
-    loginCell?.addEventListener('click', () => {
-      navigator.clipboard.writeText(account.login);
-      this.showToast('Login copied to clipboard');
-    });
-    
-    const passwordCell = row.querySelector('.password-cell');
-    passwordCell?.addEventListener('click', () => {
-      navigator.clipboard.writeText(account.password);
-      this.showToast('Password copied to clipboard');
-    });
-    
-    const playButton = row.querySelector('.action-btn.play');
-    playButton?.addEventListener('click', (e) => {
-      e.stopPropagation();
-      this.launchAccount(account);
+    tbody.addEventListener('click', (e) => {
+      const account = accountFromEvent(e);
+      if (!account) return;
+      
+      if (e.target.closest('.login-cell')) {
+        navigator.clipboard.writeText(account.login);
+        this.showToast('Login copied to clipboard');
+      } else if (e.target.closest('.password-cell')) {
+        navigator.clipboard.writeText(account.password);
+        this.showToast('Password copied to clipboard');
+      } else if (e.target.closest('.action-btn.play')) {
+        e.stopPropagation();
+        this.launchAccount(account);
+      } else if (e.target.closest('.action-btn.close')) {
+        e.stopPropagation();
+        this.closeAccount(account);
+      } else if (e.target.closest('.action-btn.webview')) {
+        e.stopPropagation();
+        this.openWebViewForAccount(account);
+      }
     });
     
-    const closeButton = row.querySelector('.action-btn.close');
-    closeButton?.addEventListener('click', (e) => {
-      e.stopPropagation();
-      this.closeAccount(account);
+    tbody.addEventListener('dblclick', (e) => {
+      const account = accountFromEvent(e);
+      if (!account || e.target.closest('.action-btn, input')) return;
+      this.selectedAccountIds.clear();
+      this.selectedAccountIds.add(account.id);
+      this.showEditAccountDialog();
     });
     
-    const webviewButton = row.querySelector('.action-btn.webview');
-    webviewButton?.addEventListener('click', (e) => {
-      e.stopPropagation();
-      this.openWebViewForAccount(account);
+    // Header clicks sort the model; a second click on the same column reverses it
+    document.querySelectorAll('#account-table th[data-sort]').forEach(th => {
+      th.addEventListener('click', () => {
+        const key = th.dataset.sort;
+        if (this.sortKey === key) {
+          this.sortDirection = -this.sortDirection;
+        } else {
+          this.sortKey = key;
+          this.sortDirection = 1;
+        }
+        document.querySelectorAll('#account-table th[data-sort]').forEach(header => {
+          header.classList.toggle('sorted-asc', header === th && this.sortDirection === 1);
+          header.classList.toggle('sorted-desc', header === th && this.sortDirection === -1);
+        });
+        this.renderAccountTable();
+      });
     });
     
-    row.addEventListener('dblclick', () => {
-      this.selectedAccountIds.clear();
-      this.selectedAccountIds.add(account.id);
-      this.showEditAccountDialog();
+    document.getElementById('account-filter')?.addEventListener('input', (e) => {
+      this.filterText = e.target.value;
+      container.scrollTop = 0;
+      this.renderAccountTable();
     });
   }
 
   selectAllAccounts(checked) {
     this.selectedAccountIds.clear();
     
+    // Select-all applies to what the filter currently shows
     if (checked) {
-      this.accounts.forEach(account => {
+      this.accountView.forEach(account => {
         this.selectedAccountIds.add(account.id);
       });
     }
     
-    document.querySelectorAll('#account-tbody tr').forEach(row => {
-      const checkbox = row.querySelector('input[type="checkbox"]');
-      if (checkbox) {
-        checkbox.checked = checked;
-      }
-      row.classList.toggle('selected', checked);
-    });
-    
+    this.renderVisibleRows(true);
     this.updateToolbarButtons();
   }
 
@@ -493,6 +881,7 @@ class PerfectWorldAccountManager {
           <div class="tab-container">
             <button class="tab-button ${initialTab === 'general' ? 'active' : ''}" data-tab="general">General</button>
             <button class="tab-button ${initialTab === 'logs' ? 'active' : ''}" data-tab="logs">Logs</button>
+            <button class="tab-button ${initialTab === 'performance' ? 'active' : ''}" data-tab="performance">Performance</button>
           </div>
           
           <div id="general-tab" class="tab-content ${initialTab === 'general' ? 'active' : ''}">
@@ -508,8 +897,35 @@ class PerfectWorldAccountManager {
                 <label>Launch Delay for Group Operations (seconds): ${this.settings?.launchDelay || 15}</label>
                 <input type="range" name="launchDelay" min="10" max="60" value="${this.settings?.launchDelay || 15}" step="1">
                 <small style="color: #666; font-size: 12px; margin-top: 4px; display: block;">
-                  Delay between launches when launching multiple clients.<br>
-                  Individual launches have no delay. First client in group launches immediately.
+                  Longest wait for a client to finish loading before the next one starts.<br>
+                  The next launch starts earlier once the client window appears or its CPU usage settles.
+                </small>
+              </div>
+              <div class="form-group">
+                <label>Concurrent Launches</label>
+                <input type="number" name="maxConcurrentLaunches" min="1" max="10" value="${this.settings?.maxConcurrentLaunches || 2}">
+                <small style="color: #666; font-size: 12px; margin-top: 4px; display: block;">
+                  How many clients may be loading at the same time during group launches.
+                </small>
+              </div>
+              <div class="form-group">
+                <label>Group Launch Resource Limits (%)</label>
+                <div style="display: flex; gap: 8px;">
+                  <input type="number" name="launchCpuLimit" min="10" max="100" value="${this.settings?.launchCpuLimit || 85}" title="CPU">
+                  <input type="number" name="launchMemoryLimit" min="10" max="100" value="${this.settings?.launchMemoryLimit || 90}" title="Memory">
+                </div>
+                <small style="color: #666; font-size: 12px; margin-top: 4px; display: block;">
+                  CPU and memory use at which the next launch waits. Memory counts clients that are still loading.
+                </small>
+              </div>
+              <div class="form-group">
+                <label>Batch File Scan Limits</label>
+                <div style="display: flex; gap: 8px;">
+                  <input type="number" name="scanMaxDepth" min="1" max="20" value="${this.settings?.scanMaxDepth || 5}" title="Folder depth">
+                  <input type="number" name="scanMaxFiles" min="1" max="100000" value="${this.settings?.scanMaxFiles || 1000}" title="Maximum accounts">
+                </div>
+                <small style="color: #666; font-size: 12px; margin-top: 4px; display: block;">
+                  Folder depth and maximum number of accounts for "Scan Batch Files".
                 </small>
               </div>
               <div class="form-group">
@@ -522,7 +938,7 @@ class PerfectWorldAccountManager {
                 </select>
                 <small style="color: #666; font-size: 12px; margin-top: 4px; display: block;">
                   <strong>Disabled:</strong> Processes remain "running" until manually closed<br>
-                  <strong>1-5 Minutes:</strong> Check if game processes still exist at selected intervals<br>
+                  <strong>1-5 Minutes:</strong> Crashes are detected as soon as a client exits; the interval sets how often a full reconciliation runs<br>
                   <strong>Note:</strong> Only monitors when clients are actively running
                 </small>
               </div>
@@ -560,6 +976,20 @@ class PerfectWorldAccountManager {
               ${this.logs.length === 0 ? '<div class="logs-empty">No logs to display</div>' : ''}
             </div>
           </div>
+          
+          <div id="performance-tab" class="tab-content ${initialTab === 'performance' ? 'active' : ''}">
+            <div class="logs-toolbar">
+              <small style="color: #666;">Timings of the most recent runs of each operation, in milliseconds</small>
+              <div>
+                <button type="button" class="btn btn-secondary" id="refresh-performance-btn" style="margin-right: 8px;">Refresh</button>
+                <button type="button" class="btn btn-secondary" id="reset-performance-btn" style="margin-right: 8px;">Reset</button>
+                <button type="button" class="btn btn-secondary" id="export-trace-btn">Export Trace</button>
+              </div>
+            </div>
+            <div class="logs-container" id="performance-container">
+              <div class="logs-empty">Loading...</div>
+            </div>
+          </div>
         </div>
         <div class="dialog-footer">
           <button type="button" class="btn btn-secondary" id="cancel-btn">Cancel</button>
@@ -599,6 +1029,8 @@ class PerfectWorldAccountManager {
           // Load logs if switching to logs tab
           if (targetTab === 'logs') {
             this.loadLogsForDialog();
+          } else if (targetTab === 'performance') {
+            this.loadPerformanceForDialog();
           }
         });
       });
@@ -606,6 +1038,8 @@ class PerfectWorldAccountManager {
       // If logs tab is initially active, render logs
       if (initialTab === 'logs') {
         this.renderLogs();
+      } else if (initialTab === 'performance') {
+        this.loadPerformanceForDialog();
       }
       
       if (delaySlider) {
@@ -638,7 +1072,19 @@ class PerfectWorldAccountManager {
       }
       
       if (logSearch) {
-        logSearch.addEventListener('input', () => this.filterLogs());
+        logSearch.addEventListener('input', () => this.filterLogs(true));
+      }
+      
+      const logsContainer = dialog.querySelector('#logs-container');
+      if (logsContainer) {
+        let scrollFrame = null;
+        logsContainer.addEventListener('scroll', () => {
+          if (scrollFrame) return;
+          scrollFrame = requestAnimationFrame(() => {
+            scrollFrame = null;
+            this.renderVisibleLogs();
+          });
+        });
       }
       
       if (clearLogsBtn) {
@@ -664,6 +1110,28 @@ class PerfectWorldAccountManager {
         });
       }
       
+      dialog.querySelector('#refresh-performance-btn')?.addEventListener('click', () => {
+        this.loadPerformanceForDialog();
+      });
+      
+      dialog.querySelector('#reset-performance-btn')?.addEventListener('click', async () => {
+        await window.electronAPI.invoke('reset-performance-metrics');
+        this.loadPerformanceForDialog();
+      });
+      
+      dialog.querySelector('#export-trace-btn')?.addEventListener('click', async () => {
+        try {
+          const result = await window.electronAPI.invoke('export-performance-trace');
+          if (result.success) {
+            this.showToast('Trace exported - open it in chrome://tracing or ui.perfetto.dev');
+          } else if (result.error) {
+            this.showErrorDialog('Export Failed', result.error);
+          }
+        } catch (error) {
+          this.showErrorDialog('Export Failed', error.message);
+        }
+      });
+      
       browseBtn.onclick = async () => {
         try {
           const result = await window.electronAPI.invoke('select-game-folder');
@@ -689,6 +1157,11 @@ class PerfectWorldAccountManager {
         const newSettings = {
           gamePath: formData.get('gamePath'),
           launchDelay: parseInt(formData.get('launchDelay'), 10),
+          maxConcurrentLaunches: parseInt(formData.get('maxConcurrentLaunches'), 10) || 2,
+          launchCpuLimit: parseInt(formData.get('launchCpuLimit'), 10) || 85,
+          launchMemoryLimit: parseInt(formData.get('launchMemoryLimit'), 10) || 90,
+          scanMaxDepth: parseInt(formData.get('scanMaxDepth'), 10) || 5,
+          scanMaxFiles: parseInt(formData.get('scanMaxFiles'), 10) || 1000,
           processMonitoringMode: formData.get('processMonitoringMode'),
           autoRestartCrashedClients: formData.get('autoRestartCrashedClients') === 'on',
         };
@@ -783,8 +1256,8 @@ class PerfectWorldAccountManager {
       if (selectedAccounts.length === 1) {
         this.showToast(`Launching ${selectedAccounts[0].login}...`);
       } else {
-        const delay = this.settings?.launchDelay || 15;
-        this.showToast(`Launching ${selectedAccounts.length} accounts with ${delay}s delay between launches...`);
+        const concurrent = this.settings?.maxConcurrentLaunches || 2;
+        this.showToast(`Launching ${selectedAccounts.length} accounts, ${concurrent} at a time...`);
       }
     } catch (error) {
       this.showErrorDialog('Failed to launch game', error.message);
@@ -806,8 +1279,8 @@ class PerfectWorldAccountManager {
         const account = this.accounts.find(a => a.id === accountIds[0]);
         this.showToast(`Launching ${account?.login || 'account'}...`);
       } else {
-        const delay = this.settings?.launchDelay || 15;
-        this.showToast(`Launching all ${accountIds.length} accounts with ${delay}s delay between launches...`);
+        const concurrent = this.settings?.maxConcurrentLaunches || 2;
+        this.showToast(`Launching all ${accountIds.length} accounts, ${concurrent} at a time...`);
       }
     } catch (error) {
       this.showErrorDialog('Failed to launch game', error.message);
@@ -894,6 +1367,15 @@ class PerfectWorldAccountManager {
   async scanFolder() {
     try {
       const result = await window.electronAPI.invoke('scan-batch-files');
+      if (result.cancelled) {
+        this.showToast(`Scan cancelled - ${result.accounts.length} account(s) found so far.`);
+      } else if (result.diff && (result.diff.unchanged > 0 || result.diff.removed.length > 0)) {
+        // Folder was scanned before - summarize what changed since then
+        const { added, modified, removed } = result.diff;
+        this.showToast(
+          `Since last scan: ${added.length} new, ${modified.length} changed, ${removed.length} removed launcher(s).`
+        );
+      }
       if (result.success && result.accounts.length > 0) {
         // Show preview dialog with found accounts
         const confirmed = await this.showScanPreviewDialog(result.accounts);
@@ -945,18 +1427,20 @@ class PerfectWorldAccountManager {
           return;
         }
 
-        const selectedAccounts = await this.showImportSelectionDialog(importData);
-        if (selectedAccounts && selectedAccounts.length > 0) {
-          const importResult = await window.electronAPI.invoke('import-selected-accounts', selectedAccounts);
+        const selection = await this.showImportSelectionDialog(importData);
+        if (selection && selection.accounts.length > 0) {
+          // The batch is written to disk before this resolves
+          const importResult = await window.electronAPI.invoke(
+            'import-selected-accounts', selection.accounts, selection.mode
+          );
           if (importResult.success) {
-            // Add a small delay to ensure database write is complete
-            await new Promise(resolve => setTimeout(resolve, 500));
-            
-            // Force reload accounts and update UI
             await this.loadAccounts();
             this.updateUI();
             
             let message = `Successfully imported ${importResult.count} accounts.`;
+            if (importResult.updated > 0) {
+              message += ` Updated ${importResult.updated} existing account(s).`;
+            }
             if (importResult.errors && importResult.errors.length > 0) {
               message += `\n\nErrors during import:\n${importResult.errors.map(e => `• ${e.login}: ${e.error}`).join('\n')}`;
               this.showErrorDialog('Import Completed with Errors', message);
@@ -1224,7 +1708,10 @@ class PerfectWorldAccountManager {
           ${importData.existing.length > 0 ? `
             <div style="margin: 12px 0; padding: 8px; background: #fff3cd; border: 1px solid #ffeaa7; border-radius: 4px;">
               <strong>⚠️ Existing accounts:</strong> ${importData.existing.join(', ')}
-              <br><small>These will be skipped during import.</small>
+              <label style="display: flex; align-items: center; margin-top: 6px;">
+                <input type="checkbox" id="update-existing-import" style="margin-right: 8px;">
+                <small>Update existing accounts with the imported values (otherwise they are skipped)</small>
+              </label>
             </div>
           ` : ''}
           <div style="margin: 16px 0;">
@@ -1239,7 +1726,7 @@ class PerfectWorldAccountManager {
                   <label style="display: flex; align-items: center; padding: 8px; border-bottom: 1px solid #eee; ${isExisting ? 'background: #f8f8f8; opacity: 0.6;' : ''}" 
                          ${isExisting ? 'title="Account already exists"' : ''}>
                     <input type="checkbox" class="account-checkbox" data-index="${index}" 
-                           ${!isExisting ? 'checked' : 'disabled'} style="margin-right: 8px;">
+                           ${isExisting ? 'data-existing="true" disabled' : 'checked'} style="margin-right: 8px;">
                     <div style="flex: 1;">
                       <strong>${this.escapeHtml(account.login || 'Unknown')}</strong>
                       <div style="font-size: 12px; color: #666;">
@@ -1263,7 +1750,8 @@ class PerfectWorldAccountManager {
       document.body.appendChild(overlay);
       
       const selectAllCheckbox = dialog.querySelector('#select-all-import');
-      const accountCheckboxes = dialog.querySelectorAll('.account-checkbox:not([disabled])');
+      const updateExistingCheckbox = dialog.querySelector('#update-existing-import');
+      let accountCheckboxes = dialog.querySelectorAll('.account-checkbox:not([disabled])');
       const importBtn = dialog.querySelector('#import-btn');
       const cancelBtn = dialog.querySelector('#cancel-btn');
       
@@ -1278,10 +1766,23 @@ class PerfectWorldAccountManager {
         updateImportButton();
       });
       
-      accountCheckboxes.forEach(cb => {
+      dialog.querySelectorAll('.account-checkbox').forEach(cb => {
         cb.addEventListener('change', updateImportButton);
       });
       
+      // Existing logins become selectable once they are going to be merged
+      updateExistingCheckbox?.addEventListener('change', () => {
+        dialog.querySelectorAll('.account-checkbox[data-existing]').forEach(cb => {
+          cb.disabled = !updateExistingCheckbox.checked;
+          cb.checked = updateExistingCheckbox.checked;
+          const row = cb.closest('label');
+          row.style.opacity = cb.disabled ? '0.6' : '1';
+          row.style.background = cb.disabled ? '#f8f8f8' : '';
+        });
+        accountCheckboxes = dialog.querySelectorAll('.account-checkbox:not([disabled])');
+        updateImportButton();
+      });
+      
       updateImportButton();
       
       const cleanup = () => overlay.remove();
@@ -1295,8 +1796,9 @@ class PerfectWorldAccountManager {
         const selectedIndices = Array.from(dialog.querySelectorAll('.account-checkbox:checked:not([disabled])'))
           .map(cb => parseInt(cb.dataset.index));
         const selectedAccounts = selectedIndices.map(i => importData.accounts[i]);
+        const mode = updateExistingCheckbox?.checked ? 'upsert' : 'insert';
         cleanup();
-        resolve(selectedAccounts);
+        resolve({ accounts: selectedAccounts, mode });
       };
       
       overlay.onclick = (e) => {
@@ -1479,41 +1981,157 @@ class PerfectWorldAccountManager {
   
   
   // Log rendering methods
-  renderLogs() {
+  
+  // Asks main for the filtered view (it keeps a search index over its buffer), then renders
+  // only the entries scrolled into view
+  async renderLogs() {
     const container = document.querySelector('#logs-container');
     if (!container) {
       console.log('📋 renderLogs: No logs container found');
       return;
     }
     
-    container.innerHTML = '';
+    const levelFilter = document.querySelector('#log-level-filter')?.value;
+    this.logFilter = {
+      level: levelFilter ? parseInt(levelFilter) : undefined,
+      searchText: document.querySelector('#log-search')?.value?.trim() || undefined,
+    };
+    
+    const requestId = ++this.logQueryId;
+    let result;
+    try {
+      result = await window.electronAPI.invoke('query-logs', this.logFilter);
+    } catch (error) {
+      console.error('Failed to query logs:', error);
+      return;
+    }
+    if (requestId !== this.logQueryId) return; // A newer filter is already on its way
     
-    const filteredLogs = this.getFilteredLogs();
-    console.log(`📋 renderLogs: Rendering ${filteredLogs.length} filtered logs from ${this.logs.length} total`);
+    // Entries that reached us while the query ran are already part of the result
+    const ids = new Set(result.entries.map(log => log.id));
+    this.pendingLogEntries = this.pendingLogEntries.filter(log => !ids.has(log.id));
     
-    if (filteredLogs.length === 0) {
+    this.logView = result.entries.reverse(); // Newest first
+    console.log(`📋 renderLogs: ${result.total} filtered logs from ${this.logs.length} total`);
+    this.renderVisibleLogs();
+  }
+  
+  renderVisibleLogs() {
+    const container = document.querySelector('#logs-container');
+    if (!container) return;
+    
+    const view = this.logView;
+    if (view.length === 0) {
       container.innerHTML = '<div class="logs-empty">No logs to display</div>';
       return;
     }
     
-    // Render in reverse order (newest first)
-    filteredLogs.reverse().forEach(log => {
-      container.appendChild(this.createLogElement(log));
-    });
+    // Collapsed entries share one height; expanded ones use their measured height
+    const base = this.logRowHeight;
+    const heightOf = (log) => (this.expandedLogIds.has(log.id) && this.logHeights.get(log.id)) || base;
+    const overscan = base * 10;
+    const top = container.scrollTop - overscan;
+    const bottom = container.scrollTop + (container.clientHeight || 400) + overscan;
+    
+    let y = 0;
+    let first = -1;
+    let last = view.length;
+    let topHeight = 0;
+    for (let i = 0; i < view.length; i++) {
+      const height = heightOf(view[i]);
+      if (first === -1 && y + height >= top) {
+        first = i;
+        topHeight = y;
+      }
+      if (y > bottom) {
+        last = i;
+        break;
+      }
+      y += height;
+    }
+    if (first === -1) first = view.length;
+    
+    let bottomHeight = 0;
+    for (let i = last; i < view.length; i++) {
+      bottomHeight += heightOf(view[i]);
+    }
+    
+    const fragment = document.createDocumentFragment();
+    fragment.appendChild(this.createLogSpacer(topHeight));
+    const rendered = [];
+    for (let i = first; i < last; i++) {
+      const element = this.createLogElement(view[i]);
+      rendered.push(element);
+      fragment.appendChild(element);
+    }
+    fragment.appendChild(this.createLogSpacer(bottomHeight));
+    container.replaceChildren(fragment);
+    
+    // Re-measure so spacer sizes track the stylesheet and expanded details
+    let changed = false;
+    for (const element of rendered) {
+      const height = element.offsetHeight;
+      if (!height) continue;
+      const id = element.dataset.logId;
+      if (this.expandedLogIds.has(id)) {
+        changed = changed || this.logHeights.get(id) !== height;
+        this.logHeights.set(id, height);
+      } else if (height !== this.logRowHeight) {
+        this.logRowHeight = height;
+        changed = true;
+      }
+    }
+    if (changed && !this.remeasuringLogs) {
+      this.remeasuringLogs = true;
+      this.renderVisibleLogs();
+      this.remeasuringLogs = false;
+    }
+  }
+  
+  createLogSpacer(height) {
+    const spacer = document.createElement('div');
+    spacer.className = 'log-spacer';
+    spacer.style.height = `${height}px`;
+    return spacer;
   }
   
+  // Live entries are queued and added to the view once per frame
   appendLogEntry(logEntry) {
-    const container = document.querySelector('#logs-container');
-    if (!container) return;
+    this.pendingLogEntries.push(logEntry);
+    if (!this.logFrame) {
+      this.logFrame = requestAnimationFrame(() => this.flushPendingLogs());
+    }
+  }
+  
+  flushPendingLogs() {
+    this.logFrame = null;
+    const added = this.pendingLogEntries.filter(log => this.logMatchesFilter(log));
+    this.pendingLogEntries = [];
+    if (added.length === 0) return;
     
-    // Remove empty message if present
-    const emptyMsg = container.querySelector('.logs-empty');
-    if (emptyMsg) {
-      emptyMsg.remove();
+    const container = document.querySelector('#logs-container');
+    this.logView = added.reverse().concat(this.logView);
+    if (this.logView.length > 1000) {
+      this.logView.length = 1000; // Same bound as the main-process buffer
     }
     
-    // Add to top (newest first)
-    container.insertBefore(this.createLogElement(logEntry), container.firstChild);
+    // Keep the reader's position when they have scrolled away from the newest entries
+    if (container && container.scrollTop > 0) {
+      container.scrollTop += added.length * this.logRowHeight;
+    }
+    this.renderVisibleLogs();
+  }
+  
+  // Single-entry check for live updates; full-buffer filtering happens in main
+  logMatchesFilter(log) {
+    const { level, searchText } = this.logFilter;
+    if (level !== undefined && log.level < level) return false;
+    if (!searchText) return true;
+    
+    const search = searchText.toLowerCase();
+    return log.message.toLowerCase().includes(search) ||
+      (log.context && log.context.toLowerCase().includes(search)) ||
+      (log.details && JSON.stringify(log.details).toLowerCase().includes(search));
   }
   
   createLogElement(log) {
@@ -1538,7 +2156,7 @@ class PerfectWorldAccountManager {
       const detailsDiv = document.createElement('div');
       detailsDiv.className = 'log-details-container';
       detailsDiv.id = `log-details-${log.id}`;
-      detailsDiv.style.display = 'none';
+      detailsDiv.style.display = this.expandedLogIds.has(log.id) ? 'block' : 'none';
       
       if (log.details) {
         const details = document.createElement('div');
@@ -1560,30 +2178,14 @@ class PerfectWorldAccountManager {
     return div;
   }
   
-  getFilteredLogs() {
-    const levelFilter = document.querySelector('#log-level-filter')?.value;
-    const searchFilter = document.querySelector('#log-search')?.value?.toLowerCase();
-    
-    let filtered = [...this.logs];
-    
-    if (levelFilter) {
-      const minLevel = parseInt(levelFilter);
-      filtered = filtered.filter(log => log.level >= minLevel);
-    }
-    
-    if (searchFilter) {
-      filtered = filtered.filter(log => 
-        log.message.toLowerCase().includes(searchFilter) ||
-        (log.context && log.context.toLowerCase().includes(searchFilter)) ||
-        (log.details && JSON.stringify(log.details).toLowerCase().includes(searchFilter))
-      );
+  // Level changes apply at once; typing is debounced so each keystroke does not re-query
+  filterLogs(debounce = false) {
+    clearTimeout(this.logSearchTimer);
+    if (debounce) {
+      this.logSearchTimer = setTimeout(() => this.renderLogs(), 200);
+    } else {
+      this.renderLogs();
     }
-    
-    return filtered;
-  }
-  
-  filterLogs() {
-    this.renderLogs();
   }
   
   async loadLogsForDialog() {
@@ -1596,6 +2198,47 @@ class PerfectWorldAccountManager {
     }
   }
   
+  async loadPerformanceForDialog() {
+    const container = document.getElementById('performance-container');
+    if (!container) return;
+    
+    try {
+      const summary = await window.electronAPI.invoke('get-performance-summary');
+      container.innerHTML = this.renderPerformanceSummary(summary);
+    } catch (error) {
+      console.error('Failed to load performance summary:', error);
+      container.innerHTML = '<div class="logs-empty">Performance data unavailable</div>';
+    }
+  }
+  
+  renderPerformanceSummary(summary) {
+    if (summary.operations.length === 0 && Object.keys(summary.counters).length === 0) {
+      return '<div class="logs-empty">Nothing measured yet</div>';
+    }
+    
+    const operations = summary.operations.map(op => `
+      <tr>
+        <td>${this.escapeHtml(op.name)}</td>
+        <td>${op.count}</td>
+        <td>${op.p50Ms}</td>
+        <td>${op.p95Ms}</td>
+        <td>${op.maxMs}</td>
+      </tr>`).join('');
+    const counters = Object.entries(summary.counters).map(([name, value]) => `
+      <tr><td>${this.escapeHtml(name)}</td><td>${value}</td></tr>`).join('');
+    const startup = Object.entries(summary.startup).map(([stage, ms]) => `
+      <tr><td>${this.escapeHtml(stage)}</td><td>${ms}</td></tr>`).join('');
+    
+    return `
+      <table class="perf-table">
+        <thead><tr><th>Operation</th><th>Count</th><th>p50</th><th>p95</th><th>Max</th></tr></thead>
+        <tbody>${operations}</tbody>
+      </table>
+      ${counters ? `<table class="perf-table"><thead><tr><th>Counter</th><th>Value</th></tr></thead><tbody>${counters}</tbody></table>` : ''}
+      ${startup ? `<table class="perf-table"><thead><tr><th>Startup stage</th><th>ms</th></tr></thead><tbody>${startup}</tbody></table>` : ''}
+    `;
+  }
+  
   async copyLogEntry(logId) {
     try {
       const result = await window.electronAPI.invoke('copy-log-entry', logId);
@@ -1608,10 +2251,13 @@ class PerfectWorldAccountManager {
   }
   
   toggleLogDetails(logId) {
-    const detailsDiv = document.querySelector(`#log-details-${logId}`);
-    if (detailsDiv) {
-      detailsDiv.style.display = detailsDiv.style.display === 'none' ? 'block' : 'none';
+    if (this.expandedLogIds.has(logId)) {
+      this.expandedLogIds.delete(logId);
+      this.logHeights.delete(logId);
+    } else {
+      this.expandedLogIds.add(logId);
     }
+    this.renderVisibleLogs();
   }
 }
 
@@ -18,6 +18,11 @@ export interface Account {
 export interface Settings {
   gamePath: string;
   launchDelay: number;
+  maxConcurrentLaunches?: number; // Clients allowed to be starting up at once during group launches
+  launchCpuLimit?: number; // System CPU % above which group launches wait
+  launchMemoryLimit?: number; // System memory % a group launch may fill up to
+  scanMaxDepth?: number; // Folder levels the batch file scan descends into
+  scanMaxFiles?: number; // Accounts after which the batch file scan stops
   processMonitoringMode?: 'disabled' | '1min' | '3min' | '5min'; // Process monitoring intervals
   autoRestartCrashedClients?: boolean; // Auto-restart clients when they crash (only when monitoring enabled)
   windowBounds?: {
@@ -33,6 +38,7 @@ export interface ProcessInfo {
   pid: number;
   login: string;
   windowTitle?: string;
+  rootPid?: number; // PID returned by spawn(); the client's process tree is followed from here
 }
 
 export interface ImportResult {
@@ -46,8 +52,60 @@ export interface LaunchResult {
   error?: string;
 }
 
+export type JobOperation = 'launch' | 'close';
+
+// State of a multi-account operation, streamed as 'job-progress' and returned by 'await-job'
+export interface JobProgress {
+  jobId: string;
+  operation: JobOperation;
+  state: 'running' | 'completed' | 'cancelled';
+  total: number;
+  done: number; // Clients launched or closed so far
+  failed: number;
+  pending: number;
+  active: string[]; // Logins currently being worked on
+  throttled?: 'cpu' | 'memory'; // Launch waiting for headroom before the next client
+  error?: string;
+}
+
+export interface SystemUsage {
+  cpuPercent: number;
+  memoryPercent: number;
+  totalMemoryBytes: number;
+  freeMemoryBytes: number;
+}
+
+export interface ClientResources {
+  cpuPercent: number; // Share of all cores since the previous sample
+  workingSetBytes: number;
+}
+
 export interface GameFolderResult {
   success: boolean;
   path?: string;
   error?: string;
 }
+
+// Timing percentiles for one instrumented operation, over its most recent samples
+export interface OperationStats {
+  name: string;
+  count: number; // Since start or the last reset
+  p50Ms: number;
+  p95Ms: number;
+  maxMs: number;
+  meanMs: number;
+}
+
+export interface PerformanceSummary {
+  operations: OperationStats[];
+  counters: Record<string, number>;
+  startup: Record<string, number>; // Stage -> ms since process start
+}
+
+// Measured in the renderer (IPC round trips, table renders) and sent to main in batches
+export interface RendererTiming {
+  name: string;
+  startedAt: number; // Epoch ms
+  durationMs: number;
+}
+
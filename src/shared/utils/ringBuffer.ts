@@ -0,0 +1,67 @@
+// Fixed-capacity FIFO: once full, each push overwrites the oldest item in O(1)
+export class RingBuffer<T> {
+  private items: (T | undefined)[];
+  private start = 0; // Index of the oldest item
+  private count = 0;
+  readonly capacity: number;
+
+  constructor(capacity: number) {
+    if (capacity < 1) {
+      throw new Error('RingBuffer capacity must be at least 1');
+    }
+    this.capacity = capacity;
+    this.items = new Array(capacity);
+  }
+
+  // Returns the evicted item when the buffer was full
+  push(item: T): T | undefined {
+    if (this.count < this.capacity) {
+      this.items[(this.start + this.count) % this.capacity] = item;
+      this.count++;
+      return undefined;
+    }
+
+    const evicted = this.items[this.start];
+    this.items[this.start] = item;
+    this.start = (this.start + 1) % this.capacity;
+    return evicted;
+  }
+
+  // 0 is the oldest item
+  get(index: number): T | undefined {
+    if (index < 0 || index >= this.count) {
+      return undefined;
+    }
+    return this.items[(this.start + index) % this.capacity];
+  }
+
+  get size(): number {
+    return this.count;
+  }
+
+  // Oldest first
+  toArray(): T[] {
+    const result: T[] = new Array(this.count);
+    for (let i = 0; i < this.count; i++) {
+      result[i] = this.items[(this.start + i) % this.capacity] as T;
+    }
+    return result;
+  }
+
+  filter(predicate: (item: T) => boolean): T[] {
+    const result: T[] = [];
+    for (let i = 0; i < this.count; i++) {
+      const item = this.items[(this.start + i) % this.capacity] as T;
+      if (predicate(item)) {
+        result.push(item);
+      }
+    }
+    return result;
+  }
+
+  clear(): void {
+    this.items = new Array(this.capacity);
+    this.start = 0;
+    this.count = 0;
+  }
+}
@@ -0,0 +1,59 @@
+interface CacheEntry<V> {
+  value: V;
+  expiresAt: number;
+}
+
+// Map with per-entry expiry. Expired entries are dropped lazily on access and by prune().
+export class TtlCache<K, V> {
+  private entries: Map<K, CacheEntry<V>> = new Map();
+  private readonly defaultTtlMs: number;
+
+  constructor(defaultTtlMs: number) {
+    this.defaultTtlMs = defaultTtlMs;
+  }
+
+  get(key: K): V | undefined {
+    const entry = this.entries.get(key);
+    if (!entry) {
+      return undefined;
+    }
+
+    if (entry.expiresAt <= Date.now()) {
+      this.entries.delete(key);
+      return undefined;
+    }
+
+    return entry.value;
+  }
+
+  has(key: K): boolean {
+    return this.get(key) !== undefined;
+  }
+
+  set(key: K, value: V, ttlMs: number = this.defaultTtlMs): void {
+    this.entries.set(key, { value, expiresAt: Date.now() + ttlMs });
+  }
+
+  delete(key: K): boolean {
+    return this.entries.delete(key);
+  }
+
+  clear(): void {
+    this.entries.clear();
+  }
+
+  // Removes all expired entries and returns how many are left
+  prune(): number {
+    const now = Date.now();
+    for (const [key, entry] of this.entries.entries()) {
+      if (entry.expiresAt <= now) {
+        this.entries.delete(key);
+      }
+    }
+    return this.entries.size;
+  }
+
+  get size(): number {
+    return this.prune();
+  }
+}
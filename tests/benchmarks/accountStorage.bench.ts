@@ -0,0 +1,120 @@
+import * as fs from 'fs/promises';
+import * as os from 'os';
+import * as path from 'path';
+import { app } from 'electron';
+import { AccountStorage } from '../../src/main/services/accountStorage';
+import { Account } from '../../src/shared/types';
+import { TestDataGenerator } from '../mocks/testDataGenerator';
+import { BenchSuite, benchSizes } from './benchHarness';
+
+const EDITS_PER_ITERATION = 100;
+
+describe('AccountStorage benchmarks', () => {
+  const suite = new BenchSuite('accountStorage');
+  const userData = app.getPath('userData');
+  let workDir: string;
+  let storage: AccountStorage | null = null;
+
+  // Leaves exactly `accounts` in the store files, or nothing at all
+  const resetStore = async (accounts: Account[] | null) => {
+    storage?.destroy();
+    storage = null;
+    for (const name of ['accounts.json', 'accounts.journal', 'roster-cache.json']) {
+      await fs.rm(path.join(userData, name), { force: true });
+    }
+    if (accounts) {
+      await fs.writeFile(path.join(userData, 'accounts.json'), JSON.stringify(accounts), 'utf-8');
+    }
+  };
+
+  beforeAll(async () => {
+    workDir = await fs.mkdtemp(path.join(os.tmpdir(), 'pw-bench-files-'));
+  });
+
+  afterAll(async () => {
+    await resetStore(null);
+    await fs.rm(workDir, { recursive: true, force: true });
+  });
+
+  for (const size of benchSizes()) {
+    describe(`${size} accounts`, () => {
+      const accounts = TestDataGenerator.generateLargeDataset(size);
+
+      it('should time loading the accounts file', async () => {
+        await resetStore(accounts);
+        await suite.measure(
+          'load',
+          async () => {
+            storage = new AccountStorage();
+            await storage.whenReady();
+          },
+          { size, teardown: () => storage?.destroy() }
+        );
+      });
+
+      it('should time saving edits into a loaded store', async () => {
+        await resetStore(accounts);
+        storage = new AccountStorage();
+        await storage.whenReady();
+        let round = 0;
+
+        await suite.measure(
+          'saveAccount',
+          async () => {
+            round++;
+            for (let i = 0; i < EDITS_PER_ITERATION; i++) {
+              const account = accounts[(i * 7919) % size];
+              await storage!.saveAccount({ ...account, description: `Edit ${round}-${i}` });
+            }
+          },
+          { size: EDITS_PER_ITERATION }
+        );
+      });
+
+      it('should time importing into an empty store', async () => {
+        const importPath = path.join(workDir, `import-${size}.json`);
+        await fs.writeFile(importPath, TestDataGenerator.generateMockAccountsJSON(size), 'utf-8');
+
+        const result = await suite.measure(
+          'importAccounts',
+          async () => {
+            await storage!.importAccounts(importPath, 'json');
+          },
+          {
+            size,
+            iterations: 3,
+            setup: async () => {
+              await resetStore(null);
+              storage = new AccountStorage();
+              await storage.whenReady();
+            },
+          }
+        );
+        expect((await storage!.getAccounts()).length).toBe(size);
+        expect(result.medianMs).toBeGreaterThan(0);
+      });
+
+      for (const format of ['json', 'csv'] as const) {
+        it(`should time exporting the roster as ${format}`, async () => {
+          await resetStore(accounts);
+          storage = new AccountStorage();
+          await storage.whenReady();
+          const exportPath = path.join(workDir, `export-${size}.${format}`);
+
+          await suite.measure(
+            `exportAllAccounts:${format}`,
+            async () => {
+              await storage!.exportAllAccounts(exportPath, format);
+            },
+            { size }
+          );
+          expect((await fs.stat(exportPath)).size).toBeGreaterThan(0);
+        });
+      }
+    });
+  }
+
+  it('should not regress against the baseline', async () => {
+    expect(await suite.save()).toEqual([]);
+  });
+});
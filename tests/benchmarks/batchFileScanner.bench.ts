@@ -0,0 +1,71 @@
+import * as fs from 'fs/promises';
+import * as os from 'os';
+import * as path from 'path';
+import { BatchFileScanner } from '../../src/main/services/batchFileScanner';
+import { BatchFileIndex } from '../../src/main/services/batchFileIndex';
+import { PlatformService } from '../mocks/platformService';
+import { TestDataGenerator } from '../mocks/testDataGenerator';
+import { BenchSuite, benchSizes } from './benchHarness';
+
+describe('BatchFileScanner benchmarks', () => {
+  const suite = new BenchSuite('batchFileScanner');
+  let workDir: string;
+
+  beforeAll(async () => {
+    PlatformService.initialize();
+    workDir = await fs.mkdtemp(path.join(os.tmpdir(), 'pw-bench-scan-'));
+  });
+
+  afterAll(async () => {
+    await fs.rm(workDir, { recursive: true, force: true });
+  });
+
+  it('should time scanning the mock game folder', async () => {
+    const mockGameFolder = path.resolve(PlatformService.getMockGamePath());
+    await suite.measure(
+      'scanFolder:mock-data',
+      () => new BatchFileScanner().scanFolder(mockGameFolder),
+      { size: 1, iterations: 20 }
+    );
+  });
+
+  for (const size of benchSizes()) {
+    describe(`${size} batch files`, () => {
+      let root: string;
+
+      beforeAll(async () => {
+        root = path.join(workDir, `tree-${size}`);
+        await TestDataGenerator.generateBatchFileTree(root, size);
+      });
+
+      it('should time a cold scan without an index', async () => {
+        let found = 0;
+        await suite.measure(
+          'scanFolder:cold',
+          async () => {
+            const accounts = await new BatchFileScanner().scanFolder(root, { maxFiles: size });
+            found = accounts.length;
+          },
+          { size, iterations: 3 }
+        );
+        expect(found).toBe(size);
+      });
+
+      it('should time a rescan of unchanged files with an index', async () => {
+        const index = new BatchFileIndex(path.join(workDir, `index-${size}.json`));
+        await index.load();
+        await new BatchFileScanner(index).scanFolder(root, { maxFiles: size });
+
+        await suite.measure(
+          'scanFolder:indexed',
+          () => new BatchFileScanner(index).scanFolder(root, { maxFiles: size }),
+          { size, iterations: 3 }
+        );
+      });
+    });
+  }
+
+  it('should not regress against the baseline', async () => {
+    expect(await suite.save()).toEqual([]);
+  });
+});
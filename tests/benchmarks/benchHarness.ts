@@ -0,0 +1,185 @@
+import * as fs from 'fs/promises';
+import * as os from 'os';
+import * as path from 'path';
+import { performance } from 'perf_hooks';
+
+export interface BenchResult {
+  name: string;
+  size: number; // Accounts, files or log entries processed per iteration
+  iterations: number;
+  meanMs: number;
+  medianMs: number;
+  p95Ms: number;
+  minMs: number;
+  maxMs: number;
+  perSecond: number; // size / median, i.e. accounts (files, entries) per second
+  heapDeltaBytes: number;
+  counters?: Record<string, number>; // Benchmark-specific figures, e.g. IPC messages sent
+}
+
+export interface BenchReport {
+  suite: string;
+  createdAt: string;
+  revision: string | null; // BENCH_REVISION, e.g. a git commit or version tag
+  node: string;
+  platform: string;
+  arch: string;
+  cpu: string;
+  cpuCount: number;
+  totalMemoryBytes: number;
+  results: BenchResult[];
+}
+
+export interface BenchRegression {
+  name: string;
+  size: number;
+  baselineMs: number;
+  currentMs: number;
+  ratio: number;
+}
+
+export interface MeasureOptions {
+  size: number;
+  iterations?: number;
+  warmup?: number;
+  setup?: () => Promise<void> | void; // Runs before every iteration, outside the timing
+  teardown?: () => Promise<void> | void;
+}
+
+// Sizes come from BENCH_SIZES (e.g. "1000,10000,100000"); the default keeps a run short
+export function benchSizes(defaults: number[] = [1000, 10000]): number[] {
+  const sizes = (process.env.BENCH_SIZES || '')
+    .split(',')
+    .map((size) => parseInt(size, 10))
+    .filter((size) => size > 0);
+  return sizes.length > 0 ? sizes : defaults;
+}
+
+// Collects timings for one benchmark file and writes them to BENCH_OUTPUT_DIR/<suite>.json.
+// With BENCH_BASELINE_DIR set to the results of an earlier version, every result whose
+// median got slower by more than BENCH_TOLERANCE (default 0.25) is reported as a regression.
+export class BenchSuite {
+  private suite: string;
+  private results: BenchResult[] = [];
+
+  constructor(suite: string) {
+    this.suite = suite;
+  }
+
+  async measure(
+    name: string,
+    fn: () => Promise<unknown> | unknown,
+    options: MeasureOptions
+  ): Promise<BenchResult> {
+    const iterations = options.iterations ?? 5;
+    const warmup = options.warmup ?? 1;
+    const samples: number[] = [];
+    const heapBefore = process.memoryUsage().heapUsed;
+
+    for (let i = 0; i < warmup + iterations; i++) {
+      await options.setup?.();
+      const started = performance.now();
+      await fn();
+      const elapsed = performance.now() - started;
+      await options.teardown?.();
+      if (i >= warmup) {
+        samples.push(elapsed);
+      }
+    }
+
+    samples.sort((a, b) => a - b);
+    const medianMs = samples[Math.floor(samples.length / 2)];
+    const result: BenchResult = {
+      name,
+      size: options.size,
+      iterations,
+      meanMs: round(samples.reduce((sum, ms) => sum + ms, 0) / samples.length),
+      medianMs: round(medianMs),
+      p95Ms: round(samples[Math.min(samples.length - 1, Math.ceil(samples.length * 0.95) - 1)]),
+      minMs: round(samples[0]),
+      maxMs: round(samples[samples.length - 1]),
+      perSecond: medianMs > 0 ? Math.round((options.size / medianMs) * 1000) : 0,
+      heapDeltaBytes: process.memoryUsage().heapUsed - heapBefore,
+    };
+
+    this.results.push(result);
+    console.log(
+      `⏱️ ${this.suite} ${name} [${options.size}]: median ${result.medianMs}ms, ` +
+        `p95 ${result.p95Ms}ms, ${result.perSecond}/s`
+    );
+    return result;
+  }
+
+  async save(): Promise<BenchRegression[]> {
+    const report: BenchReport = {
+      suite: this.suite,
+      createdAt: new Date().toISOString(),
+      revision: process.env.BENCH_REVISION || null,
+      node: process.version,
+      platform: process.platform,
+      arch: process.arch,
+      cpu: os.cpus()[0]?.model ?? 'unknown',
+      cpuCount: os.cpus().length,
+      totalMemoryBytes: os.totalmem(),
+      results: this.results,
+    };
+
+    const outputDir = path.resolve(process.env.BENCH_OUTPUT_DIR || 'bench-results');
+    await fs.mkdir(outputDir, { recursive: true });
+    await fs.writeFile(
+      path.join(outputDir, `${this.suite}.json`),
+      JSON.stringify(report, null, 2),
+      'utf8'
+    );
+
+    const baselineDir = process.env.BENCH_BASELINE_DIR;
+    if (!baselineDir) {
+      return [];
+    }
+
+    let baseline: BenchReport;
+    try {
+      const content = await fs.readFile(path.join(baselineDir, `${this.suite}.json`), 'utf8');
+      baseline = JSON.parse(content);
+    } catch {
+      console.warn(`⚠️ No baseline for ${this.suite} in ${baselineDir}`);
+      return [];
+    }
+
+    return compareReports(baseline, report, parseFloat(process.env.BENCH_TOLERANCE || '0.25'));
+  }
+}
+
+// Results slower than baseline * (1 + tolerance); differences under 2ms are treated as noise
+export function compareReports(
+  baseline: BenchReport,
+  current: BenchReport,
+  tolerance: number
+): BenchRegression[] {
+  const regressions: BenchRegression[] = [];
+  for (const result of current.results) {
+    const previous = baseline.results.find(
+      (candidate) => candidate.name === result.name && candidate.size === result.size
+    );
+    if (!previous) {
+      continue;
+    }
+    if (
+      result.medianMs > previous.medianMs * (1 + tolerance) &&
+      result.medianMs - previous.medianMs >= 2
+    ) {
+      regressions.push({
+        name: result.name,
+        size: result.size,
+        baselineMs: previous.medianMs,
+        currentMs: result.medianMs,
+        ratio: round(result.medianMs / previous.medianMs),
+      });
+    }
+  }
+  return regressions;
+}
+
+function round(value: number): number {
+  return Math.round(value * 100) / 100;
+}
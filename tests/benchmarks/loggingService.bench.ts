@@ -0,0 +1,61 @@
+import { logger, LogLevel } from '../../src/main/services/loggingService';
+import { BenchSuite, benchSizes } from './benchHarness';
+
+describe('LoggingService benchmarks', () => {
+  const suite = new BenchSuite('loggingService');
+
+  beforeAll(() => {
+    logger.setLogLevel(LogLevel.INFO);
+  });
+
+  afterAll(async () => {
+    await logger.clearLogs();
+  });
+
+  for (const size of benchSizes([10000, 100000])) {
+    describe(`${size} entries`, () => {
+      it('should time logging through to both file sinks', async () => {
+        await suite.measure(
+          'log:written',
+          async () => {
+            for (let i = 0; i < size; i++) {
+              logger.info(`Launched testuser${i}`, { pid: 1000 + i, attempt: 1 }, 'LAUNCH');
+            }
+            await logger.flush();
+          },
+          { size, iterations: 3, setup: () => logger.clearLogs() }
+        );
+      });
+
+      it('should time debug calls filtered out by level', async () => {
+        await suite.measure(
+          'log:filtered',
+          () => {
+            for (let i = 0; i < size; i++) {
+              logger.debug(() => `Polling testuser${i}`, null, 'PROCESS_MANAGER');
+            }
+          },
+          { size }
+        );
+      });
+
+      it('should time searching the in-memory buffer', async () => {
+        await logger.clearLogs();
+        for (let i = 0; i < size; i++) {
+          logger.info(`Launched testuser${i}`, { pid: 1000 + i }, i % 2 ? 'LAUNCH' : 'STORAGE');
+        }
+        await logger.flush();
+
+        await suite.measure(
+          'queryLogs:search',
+          () => logger.queryLogs({ searchText: 'testuser99', context: 'LAUNCH', limit: 200 }),
+          { size }
+        );
+      });
+    });
+  }
+
+  it('should not regress against the baseline', async () => {
+    expect(await suite.save()).toEqual([]);
+  });
+});
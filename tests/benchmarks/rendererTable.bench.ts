@@ -0,0 +1,93 @@
+import * as fs from 'fs';
+import * as path from 'path';
+import { performance } from 'perf_hooks';
+import * as vm from 'vm';
+import { TestDataGenerator } from '../mocks/testDataGenerator';
+import { createFakeDocument, FakeElement } from '../mocks/fakeDom';
+import { BenchSuite, benchSizes } from './benchHarness';
+
+// Runs the account table code from src/renderer/app.js against a fake DOM. This times the
+// view model (filter, sort) and row building the renderer does in JavaScript; layout and
+// paint are not part of it.
+function loadAccountTable(accountCount: number) {
+  const tbody = new FakeElement('tbody');
+  const container = new FakeElement('div');
+  container.clientHeight = 800;
+
+  const source = fs.readFileSync(path.resolve('src/renderer/app.js'), 'utf8');
+  const context: Record<string, any> = {
+    console,
+    performance,
+    document: createFakeDocument({ 'account-tbody': tbody, 'account-table-container': container }),
+    window: { electronAPI: { on: () => {}, invoke: async () => null } },
+  };
+  vm.runInNewContext(`${source}\nthis.AppClass = PerfectWorldAccountManager;`, context);
+
+  // The constructor wires up the whole window; the table only needs its view-model fields
+  const table = Object.create(context.AppClass.prototype);
+  Object.assign(table, {
+    accounts: TestDataGenerator.generateLargeDataset(accountCount),
+    accountsById: new Map(),
+    accountView: [],
+    filterText: '',
+    sortKey: null,
+    sortDirection: 1,
+    rowCache: new Map(),
+    rowHeight: 41,
+    renderedRange: { first: -1, last: -1 },
+    selectedAccountIds: new Set(),
+    runningProcesses: new Map(),
+    clientResources: {},
+  });
+  return { table, tbody, container };
+}
+
+describe('Renderer account table benchmarks', () => {
+  const suite = new BenchSuite('rendererTable');
+
+  for (const size of benchSizes([1000, 10000, 100000])) {
+    describe(`${size} accounts`, () => {
+      const { table, tbody, container } = loadAccountTable(size);
+
+      it('should time a full render with an empty row cache', async () => {
+        await suite.measure('renderAccountTable:cold', () => table.renderAccountTable(), {
+          size,
+          setup: () => table.rowCache.clear(),
+        });
+        expect(tbody.children.length).toBeGreaterThan(2);
+      });
+
+      it('should time filtering and sorting', async () => {
+        await suite.measure(
+          'rebuildAccountView:filter+sort',
+          () => {
+            table.filterText = 'user1';
+            table.sortKey = 'characterName';
+            table.rebuildAccountView();
+          },
+          { size }
+        );
+        table.filterText = '';
+        table.sortKey = null;
+      });
+
+      it('should time scrolling through the table', async () => {
+        table.renderAccountTable();
+        await suite.measure(
+          'renderVisibleRows:scroll',
+          () => {
+            for (let step = 0; step < 50; step++) {
+              container.scrollTop = ((step * 997) % size) * table.rowHeight;
+              table.renderVisibleRows();
+            }
+          },
+          { size: 50 }
+        );
+      });
+    });
+  }
+
+  it('should not regress against the baseline', async () => {
+    expect(await suite.save()).toEqual([]);
+  });
+});
@@ -0,0 +1,11 @@
+// Services resolve their files under app.getPath('userData'); benchmarks get a scratch
+// directory per test file instead of Electron
+jest.mock('electron', () => {
+  const fs = require('fs');
+  const os = require('os');
+  const path = require('path');
+  const userData = fs.mkdtempSync(path.join(os.tmpdir(), 'pw-bench-'));
+  return { app: { getPath: () => userData } };
+});
+
+jest.setTimeout(30 * 60 * 1000);
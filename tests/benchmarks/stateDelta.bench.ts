@@ -0,0 +1,68 @@
+import { app } from 'electron';
+import * as fs from 'fs/promises';
+import * as path from 'path';
+import { AccountStorage } from '../../src/main/services/accountStorage';
+import { StateDelta, StateDeltaPublisher } from '../../src/main/services/stateDeltaPublisher';
+import { MockProcessManager } from '../mocks/mockProcessManager';
+import { TestDataGenerator } from '../mocks/testDataGenerator';
+import { BenchSuite } from './benchHarness';
+
+// Group launches and closes through the mock process manager: how long until the renderer
+// has seen every transition, and how many state-delta messages it took
+describe('State delta benchmarks', () => {
+  const suite = new BenchSuite('stateDelta');
+  let storage: AccountStorage;
+  let processManager: MockProcessManager;
+
+  beforeAll(async () => {
+    await fs.rm(path.join(app.getPath('userData'), 'accounts.json'), { force: true });
+    storage = new AccountStorage();
+    await storage.whenReady();
+    processManager = new MockProcessManager();
+  });
+
+  afterAll(() => {
+    processManager.destroy();
+    storage.destroy();
+  });
+
+  for (const clients of [40, 200]) {
+    it(`should time a launch and close of ${clients} clients`, async () => {
+      const accounts = TestDataGenerator.generateMockAccounts(clients);
+      let messages = 0;
+      let processUpdates = 0;
+      const publisher = new StateDeltaPublisher(
+        storage,
+        processManager as any,
+        (delta: StateDelta) => {
+          messages++;
+          processUpdates += delta.processes.length;
+        }
+      );
+
+      const result = await suite.measure(
+        'groupLaunchClose',
+        async () => {
+          await Promise.all(accounts.map((account) => processManager.launchGame(account, '')));
+          await Promise.all(accounts.map((account) => processManager.closeGame(account.id)));
+          await publisher.flush();
+        },
+        {
+          size: clients,
+          setup: () => {
+            messages = 0;
+            processUpdates = 0;
+          },
+        }
+      );
+      result.counters = { messages, processUpdates };
+      publisher.destroy();
+
+      expect(messages).toBeLessThan(clients);
+    });
+  }
+
+  it('should not regress against the baseline', async () => {
+    expect(await suite.save()).toEqual([]);
+  });
+});
@@ -1,5 +1,8 @@
 import * as path from 'path';
+import * as os from 'os';
+import * as fs from 'fs/promises';
 import { BatchFileScanner } from '../../src/main/services/batchFileScanner';
+import { BatchFileIndex } from '../../src/main/services/batchFileIndex';
 import { PlatformService } from '../mocks/platformService';
 
 describe('Batch File Scanner Integration', () => {
@@ -209,4 +212,74 @@ describe('Batch File Scanner Integration', () => {
       });
     });
   });
-});
\ No newline at end of file
+
+  describe('Incremental Rescans', () => {
+    let dir: string;
+    let indexPath: string;
+
+    const writeLauncher = (name: string, login: string) =>
+      fs.writeFile(
+        path.join(dir, name),
+        `@echo off\r\nstart elementclient.exe user:${login} pwd:pass\r\n`
+      );
+
+    beforeEach(async () => {
+      dir = await fs.mkdtemp(path.join(os.tmpdir(), 'pw-scan-'));
+      indexPath = path.join(dir, 'index', 'batch-index.json');
+      await writeLauncher('a.bat', 'alpha');
+      await writeLauncher('b.bat', 'beta');
+    });
+
+    afterEach(async () => {
+      await fs.rm(dir, { recursive: true, force: true });
+    });
+
+    it('should report everything as added on the first scan', async () => {
+      const indexed = new BatchFileScanner(new BatchFileIndex(indexPath));
+      await indexed.scanFolder(dir);
+
+      const diff = indexed.getLastScanDiff();
+      expect(diff?.added.map((p) => path.basename(p)).sort()).toEqual(['a.bat', 'b.bat']);
+      expect(diff?.unchanged).toBe(0);
+      expect(scanner.getLastScanDiff()).toBeNull();
+    });
+
+    it('should reuse unchanged files and diff the rest from the persisted index', async () => {
+      await new BatchFileScanner(new BatchFileIndex(indexPath)).scanFolder(dir);
+
+      await writeLauncher('b.bat', 'beta-renamed');
+      await writeLauncher('c.bat', 'gamma');
+      await fs.rm(path.join(dir, 'a.bat'));
+      await fs.utimes(path.join(dir, 'b.bat'), new Date(), new Date(Date.now() + 5000));
+
+      // A fresh index instance proves the fingerprints were persisted
+      const rescanner = new BatchFileScanner(new BatchFileIndex(indexPath));
+      const accounts = await rescanner.scanFolder(dir);
+
+      const diff = rescanner.getLastScanDiff();
+      expect(diff?.added.map((p) => path.basename(p))).toEqual(['c.bat']);
+      expect(diff?.modified.map((p) => path.basename(p))).toEqual(['b.bat']);
+      expect(diff?.removed.map((p) => path.basename(p))).toEqual(['a.bat']);
+      expect(accounts.map((a) => a.login).sort()).toEqual(['beta-renamed', 'gamma']);
+
+      // Passwords are not persisted, so a fresh index re-reads the launchers once
+      const warm = new BatchFileScanner(new BatchFileIndex(indexPath));
+      await warm.scanFolder(dir);
+      expect(warm.getLastScanDiff()?.unchanged).toBe(2);
+      expect(warm.getLastScanStats().filesReused).toBe(0);
+
+      const rescanned = await warm.scanFolder(dir);
+      expect(warm.getLastScanDiff()?.unchanged).toBe(2);
+      expect(warm.getLastScanStats().filesReused).toBe(2);
+      expect(rescanned.map((a) => a.password)).toEqual(['pass', 'pass']);
+    });
+
+    it('should keep passwords out of the persisted index', async () => {
+      await new BatchFileScanner(new BatchFileIndex(indexPath)).scanFolder(dir);
+
+      const saved = await fs.readFile(indexPath, 'utf-8');
+      expect(saved.includes('alpha')).toBe(true);
+      expect(saved.includes('pass')).toBe(false);
+    });
+  });
+});
@@ -0,0 +1,85 @@
+// Just enough of the DOM for the renderer's table code to run under Node: elements keep
+// their markup and children but do no parsing or layout. querySelector hands back a child
+// stand-in, so code that patches cells after setting innerHTML still runs.
+export class FakeElement {
+  tagName: string;
+  children: FakeElement[] = [];
+  dataset: Record<string, string> = {};
+  style: Record<string, string> = {};
+  className = '';
+  disabled = false;
+  checked = false;
+  scrollTop = 0;
+  clientHeight = 0;
+  offsetHeight = 0;
+  private markup = '';
+  private text = '';
+  private queried: Map<string, FakeElement> = new Map();
+
+  classList = {
+    toggle: (name: string, force?: boolean) => {
+      const classes = new Set(this.className.split(' ').filter(Boolean));
+      const add = force ?? !classes.has(name);
+      if (add) classes.add(name);
+      else classes.delete(name);
+      this.className = Array.from(classes).join(' ');
+      return add;
+    },
+  };
+
+  constructor(tagName: string) {
+    this.tagName = tagName.toUpperCase();
+  }
+
+  get innerHTML(): string {
+    return this.markup;
+  }
+
+  set innerHTML(markup: string) {
+    this.markup = markup;
+    this.queried.clear();
+  }
+
+  get textContent(): string {
+    return this.text;
+  }
+
+  set textContent(text: string) {
+    this.text = String(text ?? '');
+    this.markup = this.text
+      .replace(/&/g, '&amp;')
+      .replace(/</g, '&lt;')
+      .replace(/>/g, '&gt;');
+  }
+
+  appendChild(child: FakeElement): FakeElement {
+    this.children.push(child);
+    return child;
+  }
+
+  replaceChildren(...nodes: FakeElement[]): void {
+    this.children = nodes.flatMap((node) =>
+      node.tagName === '#FRAGMENT' ? node.children : [node]
+    );
+  }
+
+  replaceWith(): void {}
+
+  querySelector(selector: string): FakeElement {
+    let element = this.queried.get(selector);
+    if (!element) {
+      element = new FakeElement('span');
+      this.queried.set(selector, element);
+    }
+    return element;
+  }
+}
+
+export function createFakeDocument(elementsById: Record<string, FakeElement>) {
+  return {
+    createElement: (tagName: string) => new FakeElement(tagName),
+    createDocumentFragment: () => new FakeElement('#fragment'),
+    getElementById: (id: string) => elementsById[id] ?? null,
+    addEventListener: () => {},
+  };
+}
@@ -71,6 +71,10 @@ export class MockProcessManager extends EventEmitter {
     return Array.from(this.processes.values());
   }
 
+  getProcessInfo(accountId: string): MockProcess | undefined {
+    return this.processes.get(accountId);
+  }
+
   private startProcessMonitoring(): void {
     this.processCheckInterval = setInterval(() => {
       // Simulate process status checking
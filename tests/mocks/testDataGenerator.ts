@@ -1,3 +1,5 @@
+import * as fs from 'fs/promises';
+import * as path from 'path';
 import * as iconv from 'iconv-lite';
 import { Account } from '../../src/shared/types';
 import { generateAccountId } from '../../src/shared/utils/validation';
@@ -129,6 +131,31 @@ test3,pass3,server3,extra,fields,here`;
     return accounts;
   }
 
+  // Writes `count` launcher files under root, filesPerFolder per folder in a two-level tree
+  // (group_0/folder_0/...), alternating UTF-8 and CP1251 like real game installs
+  static async generateBatchFileTree(
+    root: string,
+    count: number,
+    filesPerFolder: number = 50
+  ): Promise<void> {
+    const folders = Math.ceil(count / filesPerFolder);
+    for (let folder = 0; folder < folders; folder++) {
+      const dir = path.join(root, `group_${Math.floor(folder / 20)}`, `folder_${folder}`);
+      await fs.mkdir(dir, { recursive: true });
+
+      const first = folder * filesPerFolder;
+      const last = Math.min(count, first + filesPerFolder);
+      const writes: Promise<void>[] = [];
+      for (let i = first; i < last; i++) {
+        const account = this.generateMockAccount(i + 1);
+        const encoding = i % 2 === 0 ? 'utf8' : 'cp1251';
+        const filePath = path.join(dir, `${account.login}.bat`);
+        writes.push(fs.writeFile(filePath, this.generateMockBatchFile(account, encoding)));
+      }
+      await Promise.all(writes);
+    }
+  }
+
   static generateAccountWithSpecialCharacters(): Account {
     return {
       id: generateAccountId(),
@@ -0,0 +1,115 @@
+import * as fs from 'fs/promises';
+import * as os from 'os';
+import * as path from 'path';
+import {
+  CsvStreamParser,
+  JsonAccountStreamParser,
+  readAccountFile,
+  writeAccountFile,
+} from '../../src/main/services/accountFileStream';
+import { Account } from '../../src/shared/types';
+
+// Feeds text one character at a time so every state crosses a chunk boundary
+function feed(parser: { write(chunk: string): void; end(): void }, text: string) {
+  for (const ch of text) {
+    parser.write(ch);
+  }
+  parser.end();
+}
+
+describe('accountFileStream', () => {
+  let dir: string;
+
+  beforeEach(async () => {
+    dir = await fs.mkdtemp(path.join(os.tmpdir(), 'pw-stream-'));
+  });
+
+  afterEach(async () => {
+    await fs.rm(dir, { recursive: true, force: true });
+  });
+
+  it('should parse RFC 4180 quoting across chunks', () => {
+    const rows: string[][] = [];
+    feed(
+      new CsvStreamParser((row) => rows.push(row)),
+      'login,description\r\n"alpha","farms, then ""buffs""\r\nat night"\r\n\r\nbeta,\n'
+    );
+
+    expect(rows).toEqual([
+      ['login', 'description'],
+      ['alpha', 'farms, then "buffs"\r\nat night'],
+      ['beta', ''],
+    ]);
+  });
+
+  it('should stream accounts from bare arrays and the old wrapper format', () => {
+    const fromArray: any[] = [];
+    feed(
+      new JsonAccountStreamParser((a) => fromArray.push(a)),
+      '[{"login":"a]\\"{","nested":{"x":[1]}}, {"login":"b"}]'
+    );
+    expect(fromArray.map((a) => a.login)).toEqual(['a]"{', 'b']);
+
+    const fromWrapper: any[] = [];
+    feed(
+      new JsonAccountStreamParser((a) => fromWrapper.push(a)),
+      '{"metadata":{"accounts":1},"accounts":[{"login":"c"}]}'
+    );
+    expect(fromWrapper.map((a) => a.login)).toEqual(['c']);
+
+    const single: any[] = [];
+    feed(new JsonAccountStreamParser((a) => single.push(a)), '{"login":"d"}');
+    expect(single.map((a) => a.login)).toEqual(['d']);
+  });
+
+  it('should round-trip exports through the streaming reader', async () => {
+    const accounts: Account[] = [
+      { id: '1', login: 'alpha', password: 'p,"1"', server: 'Main', description: 'a\nb' },
+      { id: '2', login: 'beta', password: 'p2', server: 'X', characterName: 'Воин' },
+    ];
+
+    const jsonPath = path.join(dir, 'accounts.json');
+    await writeAccountFile(jsonPath, accounts, 'json');
+    expect(await fs.readFile(jsonPath, 'utf-8')).toBe(JSON.stringify(accounts, null, 2));
+
+    const csvPath = path.join(dir, 'accounts.csv');
+    await writeAccountFile(csvPath, accounts, 'csv');
+    const parsed: any[] = [];
+    await readAccountFile(csvPath, 'csv', (a) => parsed.push(a));
+
+    expect(parsed).toEqual([
+      { login: 'alpha', password: 'p,"1"', server: 'Main', description: 'a\nb' },
+      { login: 'beta', password: 'p2', server: 'X', characterName: 'Воин' },
+    ]);
+  });
+
+  it('should write an export in chunks with the same bytes as one call', async () => {
+    const accounts: Account[] = [1, 2, 3].map((i) => ({
+      id: String(i),
+      login: `user${i}`,
+      password: 'secret',
+      server: 'Main',
+    }));
+
+    for (const format of ['json', 'csv'] as const) {
+      const whole = path.join(dir, `whole.${format}`);
+      const chunked = path.join(dir, `chunked.${format}`);
+      await writeAccountFile(whole, accounts, format);
+      await writeAccountFile(chunked, accounts.slice(0, 2), format, undefined, {
+        index: 0,
+        last: false,
+      });
+      await writeAccountFile(chunked, accounts.slice(2), format, undefined, {
+        index: 2,
+        last: false,
+      });
+      await writeAccountFile(chunked, [], format, undefined, { index: 3, last: true });
+
+      expect(await fs.readFile(chunked, 'utf-8')).toBe(await fs.readFile(whole, 'utf-8'));
+    }
+
+    const empty = path.join(dir, 'empty.json');
+    await writeAccountFile(empty, [], 'json', undefined, { index: 0, last: true });
+    expect(await fs.readFile(empty, 'utf-8')).toBe('[]');
+  });
+});
@@ -0,0 +1,73 @@
+import { AccountIndex } from '../../src/main/services/accountIndex';
+import { Account } from '../../src/shared/types';
+
+function makeAccount(id: string, login: string, overrides: Partial<Account> = {}): Account {
+  return {
+    id,
+    login,
+    password: 'password',
+    server: 'Main',
+    ...overrides,
+  };
+}
+
+describe('AccountIndex', () => {
+  let index: AccountIndex;
+
+  beforeEach(() => {
+    index = new AccountIndex([
+      makeAccount('1', 'alpha', { owner: 'Alice' }),
+      makeAccount('2', 'beta', { server: 'X', owner: 'Bob' }),
+      makeAccount('3', 'gamma', { server: 'X', owner: 'Alice' }),
+    ]);
+  });
+
+  it('should look up accounts by id and login', () => {
+    expect(index.size).toBe(3);
+    expect(index.getById('2')?.login).toBe('beta');
+    expect(index.getByLogin('gamma')?.id).toBe('3');
+    expect(index.getByLogin('missing')).toBeUndefined();
+    expect(index.hasLogin('alpha')).toBe(true);
+  });
+
+  it('should keep insertion order in values', () => {
+    expect(index.values().map((a) => a.id)).toEqual(['1', '2', '3']);
+  });
+
+  it('should group accounts by server and owner', () => {
+    expect(index.getByServer('X').map((a) => a.id)).toEqual(['2', '3']);
+    expect(index.getByServer('Main').map((a) => a.id)).toEqual(['1']);
+    expect(index.getByOwner('Alice').map((a) => a.id)).toEqual(['1', '3']);
+    expect(index.getByOwner('Nobody')).toEqual([]);
+  });
+
+  it('should re-key indexes when an account is updated', () => {
+    index.set(makeAccount('1', 'alpha2', { server: 'X' }));
+
+    expect(index.getByLogin('alpha')).toBeUndefined();
+    expect(index.getByLogin('alpha2')?.id).toBe('1');
+    expect(index.getByServer('Main')).toEqual([]);
+    expect(index.getByServer('X').map((a) => a.id)).toEqual(['2', '3', '1']);
+    expect(index.getByOwner('Alice').map((a) => a.id)).toEqual(['3']);
+    expect(index.values().map((a) => a.id)).toEqual(['1', '2', '3']);
+  });
+
+  it('should remove accounts from every index on delete', () => {
+    expect(index.delete('2')).toBe(true);
+    expect(index.delete('2')).toBe(false);
+
+    expect(index.getById('2')).toBeUndefined();
+    expect(index.hasLogin('beta')).toBe(false);
+    expect(index.getByServer('X').map((a) => a.id)).toEqual(['3']);
+    expect(index.getByOwner('Bob')).toEqual([]);
+    expect(index.size).toBe(2);
+  });
+
+  it('should reset everything on load', () => {
+    index.load([makeAccount('9', 'delta')]);
+
+    expect(index.size).toBe(1);
+    expect(index.hasLogin('alpha')).toBe(false);
+    expect(index.getByOwner('Alice')).toEqual([]);
+  });
+});
@@ -0,0 +1,89 @@
+import * as fs from 'fs/promises';
+import * as os from 'os';
+import * as path from 'path';
+import { AccountPersistence } from '../../src/main/services/accountPersistence';
+import { Account } from '../../src/shared/types';
+
+function makeAccount(id: string, login: string): Account {
+  return { id, login, password: 'password', server: 'Main' };
+}
+
+describe('AccountPersistence', () => {
+  let dir: string;
+  let snapshotPath: string;
+  let journalPath: string;
+  let state: Account[];
+
+  const create = (compactThreshold = 200) =>
+    new AccountPersistence(snapshotPath, () => state, { flushDelay: 10, compactThreshold });
+
+  beforeEach(async () => {
+    dir = await fs.mkdtemp(path.join(os.tmpdir(), 'pw-accounts-'));
+    snapshotPath = path.join(dir, 'accounts.json');
+    journalPath = path.join(dir, 'accounts.journal');
+    state = [];
+  });
+
+  afterEach(async () => {
+    await fs.rm(dir, { recursive: true, force: true });
+  });
+
+  it('should load an existing accounts.json without a journal', async () => {
+    await fs.writeFile(snapshotPath, JSON.stringify([makeAccount('1', 'alpha')], null, 2));
+
+    const accounts = await create().load();
+    expect(accounts.map((a) => a.login)).toEqual(['alpha']);
+  });
+
+  it('should replay journal records over the snapshot', async () => {
+    await fs.writeFile(snapshotPath, JSON.stringify([makeAccount('1', 'alpha')]));
+
+    const persistence = create();
+    persistence.recordPut(makeAccount('2', 'beta'));
+    persistence.recordPut({ ...makeAccount('1', 'alpha'), owner: 'Alice' });
+    persistence.recordDelete('2');
+    await persistence.flush();
+
+    const accounts = await create().load();
+    expect(accounts).toHaveLength(1);
+    expect(accounts[0].owner).toBe('Alice');
+  });
+
+  it('should ignore a torn final journal line and compact it away', async () => {
+    await fs.writeFile(
+      journalPath,
+      JSON.stringify({ op: 'put', account: makeAccount('1', 'alpha') }) + '\n{"op":"put","acc'
+    );
+
+    const persistence = create();
+    state = await persistence.load();
+    expect(state.map((a) => a.login)).toEqual(['alpha']);
+
+    await persistence.compactIfNeeded();
+    expect(await fs.readFile(journalPath, 'utf-8')).toBe('');
+    expect(JSON.parse(await fs.readFile(snapshotPath, 'utf-8'))).toHaveLength(1);
+  });
+
+  it('should compact into the snapshot once the journal reaches the threshold', async () => {
+    const persistence = create(2);
+    state = [makeAccount('1', 'alpha'), makeAccount('2', 'beta')];
+    persistence.recordPut(state[0]);
+    persistence.recordPut(state[1]);
+    await persistence.flush();
+    await persistence.flush(); // Queued behind the background compaction
+
+    expect(await fs.readFile(journalPath, 'utf-8')).toBe('');
+    const snapshot = JSON.parse(await fs.readFile(snapshotPath, 'utf-8'));
+    expect(snapshot.map((a: Account) => a.login)).toEqual(['alpha', 'beta']);
+    await expect(fs.access(`${snapshotPath}.tmp`)).rejects.toThrow();
+  });
+
+  it('should write pending records synchronously on flushSync', async () => {
+    const persistence = create();
+    persistence.recordPut(makeAccount('1', 'alpha'));
+    persistence.flushSync();
+
+    const accounts = await create().load();
+    expect(accounts.map((a) => a.login)).toEqual(['alpha']);
+  });
+});
@@ -0,0 +1,73 @@
+import { decodeBatchFile, parseBatchContent } from '../../src/main/services/batchFileFormat';
+
+// Byte values of the Cyrillic letters used below in each single-byte code page
+const LETTERS = 'ПриветЁжк';
+const CP1251 = [0xcf, 0xf0, 0xe8, 0xe2, 0xe5, 0xf2, 0xa8, 0xe6, 0xea];
+const CP866 = [0x8f, 0xe0, 0xa8, 0xa2, 0xa5, 0xe2, 0xf0, 0xa6, 0xaa];
+
+const encode = (text: string, codePage: number[]) =>
+  Uint8Array.from(text, (ch) => (ch < '\x80' ? ch.charCodeAt(0) : codePage[LETTERS.indexOf(ch)]));
+
+describe('batchFileFormat', () => {
+  describe('parseBatchContent', () => {
+    it('should read arguments from the start line', () => {
+      const account = parseBatchContent(
+        '@echo off\r\nstart "" "elementclient.exe" startbypatcher user:alpha pwd:secret server:X role:Hero\r\n'
+      );
+
+      expect(account).toEqual({
+        login: 'alpha',
+        password: 'secret',
+        server: 'X',
+        characterName: 'Hero',
+      });
+    });
+
+    it('should fall back to REM comments and prefer arguments over them', () => {
+      const account = parseBatchContent(
+        [
+          'REM Account: commentLogin',
+          'REM Server: X',
+          'rem Owner: Alice',
+          'REM Description:  Main farmer ',
+          'REM Character: Comment Hero',
+          'start "" "elementclient.exe" user:argLogin pwd:secret role:',
+        ].join('\r\n')
+      );
+
+      expect(account.login).toBe('argLogin');
+      expect(account.server).toBe('X');
+      expect(account.owner).toBe('Alice');
+      expect(account.description).toBe('Main farmer');
+      expect(account.characterName).toBe('Comment Hero');
+    });
+
+    it('should keep the first occurrence and default unknown servers to Main', () => {
+      const account = parseBatchContent('user:first pwd:a\nuser:second pwd:b server:Other\n');
+
+      expect(account.login).toBe('first');
+      expect(account.password).toBe('a');
+      expect(account.server).toBe('Main');
+    });
+  });
+
+  describe('decodeBatchFile', () => {
+    it('should decode UTF-8 with and without a BOM', () => {
+      const utf8 = Buffer.from('rem Character: Воин', 'utf8');
+      const withBom = Buffer.concat([Buffer.from([0xef, 0xbb, 0xbf]), utf8]);
+
+      expect(decodeBatchFile(utf8)).toEqual({ text: 'rem Character: Воин', encoding: 'utf-8' });
+      expect(decodeBatchFile(withBom).text).toBe('rem Character: Воин');
+    });
+
+    it('should detect windows-1251 and cp866 launchers', () => {
+      const text = 'role:Привет rem Character: Ёжик';
+
+      const cp1251 = decodeBatchFile(encode(text, CP1251));
+      expect(cp1251).toEqual({ text, encoding: 'windows-1251' });
+
+      const cp866 = decodeBatchFile(encode(text, CP866));
+      expect(cp866).toEqual({ text, encoding: 'ibm866' });
+    });
+  });
+});
@@ -0,0 +1,83 @@
+import * as fs from 'fs/promises';
+import * as os from 'os';
+import * as path from 'path';
+import { CoalescedFileWriter } from '../../src/main/services/coalescedFileWriter';
+
+describe('CoalescedFileWriter', () => {
+  let dir: string;
+  let filePath: string;
+  let value: number;
+  let serializations: number;
+
+  const create = (delay = 10) =>
+    new CoalescedFileWriter(
+      filePath,
+      () => {
+        serializations++;
+        return JSON.stringify({ value });
+      },
+      delay
+    );
+
+  const read = async () => JSON.parse(await fs.readFile(filePath, 'utf-8'));
+
+  beforeEach(async () => {
+    dir = await fs.mkdtemp(path.join(os.tmpdir(), 'pw-writer-'));
+    filePath = path.join(dir, 'config.json');
+    value = 0;
+    serializations = 0;
+  });
+
+  afterEach(async () => {
+    await fs.rm(dir, { recursive: true, force: true });
+  });
+
+  it('should coalesce a burst of changes into one write', async () => {
+    const writer = create();
+    for (let i = 1; i <= 20; i++) {
+      value = i;
+      writer.schedule();
+    }
+
+    await new Promise((resolve) => setTimeout(resolve, 50));
+    expect(serializations).toBe(1);
+    expect(await read()).toEqual({ value: 20 });
+    expect(writer.pending).toBe(false);
+  });
+
+  it('should write pending changes immediately on flush', async () => {
+    const writer = create(10000);
+    value = 7;
+    writer.schedule();
+
+    await writer.flush();
+    expect(await read()).toEqual({ value: 7 });
+    expect((await fs.readdir(dir)).sort()).toEqual(['config.json']);
+  });
+
+  it('should write the latest state synchronously on flushSync', async () => {
+    const writer = create(10000);
+    value = 3;
+    writer.schedule();
+
+    writer.flushSync();
+    expect(await read()).toEqual({ value: 3 });
+    expect(writer.pending).toBe(false);
+  });
+
+  it('should keep the change pending when the write fails', async () => {
+    filePath = path.join(dir, 'blocked', 'config.json');
+    await fs.writeFile(path.join(dir, 'blocked'), 'not a directory');
+    const writer = create();
+    const originalError = console.error;
+    console.error = () => undefined;
+
+    try {
+      writer.schedule();
+      await writer.flush();
+      expect(writer.pending).toBe(true);
+    } finally {
+      console.error = originalError;
+    }
+  });
+});
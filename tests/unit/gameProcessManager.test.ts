@@ -0,0 +1,76 @@
+// Logging resolves its files under app.getPath('userData'); give it a scratch directory
+jest.mock('electron', () => {
+  const fs = require('fs');
+  const os = require('os');
+  const path = require('path');
+  const userData = fs.mkdtempSync(path.join(os.tmpdir(), 'pw-processes-'));
+  return { app: { getPath: () => userData } };
+});
+
+import { spawn, ChildProcess } from 'child_process';
+import { once } from 'events';
+import { GameProcessManager } from '../../src/main/services/gameProcessManager';
+import { ProcessInfo } from '../../src/shared/types';
+
+// Runs on the non-Windows kill path: tree roots get SIGTERM, snapshot PIDs are never alive
+const describeUnix = process.platform === 'win32' ? describe.skip : describe;
+
+describeUnix('GameProcessManager.closeMultipleGames', () => {
+  let manager: GameProcessManager;
+  let children: ChildProcess[];
+
+  const track = (info: ProcessInfo) => {
+    (manager as any).processes.set(info.accountId, info);
+  };
+
+  beforeEach(() => {
+    manager = new GameProcessManager();
+    children = [];
+  });
+
+  afterEach(() => {
+    manager.destroy();
+    for (const child of children) {
+      child.kill('SIGKILL');
+    }
+  });
+
+  it('should close everything with one batched status update and count failures', async () => {
+    const live = spawn('sleep', ['30']);
+    const gone = spawn('true');
+    children.push(live, gone);
+    await once(gone, 'exit');
+
+    track({ accountId: 'a', login: 'alpha', pid: -2, rootPid: live.pid });
+    track({ accountId: 'b', login: 'beta', pid: -2, rootPid: gone.pid });
+    track({ accountId: 'c', login: 'gamma', pid: 424242 });
+
+    const single: string[] = [];
+    const batches: { accountId: string; running: boolean }[][] = [];
+    manager.on('status-update', (accountId: string) => single.push(accountId));
+    manager.on('status-update-batch', (updates) => batches.push(updates));
+
+    const liveExit = once(live, 'exit');
+    const failures = await manager.closeMultipleGames(['a', 'b', 'c', 'unknown']);
+
+    expect(failures).toBe(1); // The root that had already exited
+    expect(single).toEqual([]);
+    expect(batches).toEqual([
+      [
+        { accountId: 'a', running: false },
+        { accountId: 'b', running: false },
+        { accountId: 'c', running: false },
+      ],
+    ]);
+    expect(manager.getRunningProcesses()).toEqual([]);
+    expect((await liveExit)[1]).toBe('SIGTERM');
+  });
+
+  it('should report nothing when no selected account is running', async () => {
+    const batches: unknown[] = [];
+    manager.on('status-update-batch', (updates) => batches.push(updates));
+
+    expect(await manager.closeMultipleGames(['missing'])).toBe(0);
+    expect(batches).toEqual([]);
+  });
+});
@@ -0,0 +1,199 @@
+// Logging resolves its files under app.getPath('userData'); give it a scratch directory
+jest.mock('electron', () => {
+  const fs = require('fs');
+  const os = require('os');
+  const path = require('path');
+  const userData = fs.mkdtempSync(path.join(os.tmpdir(), 'pw-scheduler-'));
+  return { app: { getPath: () => userData } };
+});
+
+import { LaunchScheduler } from '../../src/main/services/launchScheduler';
+import type { GameProcessManager } from '../../src/main/services/gameProcessManager';
+import {
+  ElementClientProcess,
+  processSnapshot,
+} from '../../src/main/services/processSnapshotService';
+import type { ResourceMonitor } from '../../src/main/services/resourceMonitor';
+import { Account, JobProgress, SystemUsage } from '../../src/shared/types';
+import { MockProcessManager } from '../mocks/mockProcessManager';
+import { TestDataGenerator } from '../mocks/testDataGenerator';
+
+const GB = 1024 * 1024 * 1024;
+
+// Fixed ids: generateAccountId() repeats itself under fake timers and a stubbed Math.random
+const makeAccounts = (count: number): Account[] =>
+  TestDataGenerator.generateMockAccounts(count).map((account, i) => ({
+    ...account,
+    id: `account-${i + 1}`,
+  }));
+
+// Headroom comes from here instead of the machine running the tests
+class StubResourceMonitor {
+  usage: SystemUsage = {
+    cpuPercent: 10,
+    memoryPercent: 25,
+    totalMemoryBytes: 16 * GB,
+    freeMemoryBytes: 12 * GB,
+  };
+  footprints = new Map<string, number>();
+
+  async sampleSystem(): Promise<SystemUsage> {
+    return this.usage;
+  }
+
+  expectedFootprint(accountId: string): number {
+    return this.footprints.get(accountId) ?? GB;
+  }
+}
+
+describe('LaunchScheduler', () => {
+  const originalRandom = Math.random;
+  const originalGetCachedProcess = processSnapshot.getCachedProcess;
+  let manager: MockProcessManager;
+  let monitor: StubResourceMonitor;
+  let scheduler: LaunchScheduler;
+  let progress: JobProgress[];
+  let launched: string[];
+  let windows: Map<number, string> | null; // Null: every client is ready as soon as it starts
+
+  const start = (accounts: Account[], maxConcurrent: number, launchDelay = 30) =>
+    scheduler.start('job-1', accounts, 'C:\\Games\\elementclient.exe', {
+      maxConcurrent,
+      launchDelay,
+    });
+
+  const last = () => progress[progress.length - 1];
+
+  beforeEach(() => {
+    jest.useFakeTimers();
+    Math.random = () => 0.5; // No simulated launch failures or random crashes
+
+    manager = new MockProcessManager();
+    const launchGame = manager.launchGame.bind(manager);
+    launched = [];
+    manager.launchGame = (account, gamePath) => {
+      launched.push(account.login);
+      return launchGame(account, gamePath);
+    };
+
+    // Clients in `windows` stay loading until a title is set for their PID
+    windows = null;
+    processSnapshot.getCachedProcess = (pid: number): ElementClientProcess | undefined =>
+      windows
+        ? {
+            pid,
+            parentPid: 0,
+            startTime: new Date(),
+            windowTitle: windows.get(pid) ?? '',
+            cpuSeconds: 0,
+            workingSetBytes: 0,
+          }
+        : undefined;
+
+    monitor = new StubResourceMonitor();
+    scheduler = new LaunchScheduler(
+      manager as unknown as GameProcessManager,
+      monitor as unknown as ResourceMonitor
+    );
+    progress = [];
+    scheduler.on('progress', (update: JobProgress) => progress.push(update));
+  });
+
+  afterEach(() => {
+    scheduler.destroy();
+    manager.destroy();
+    processSnapshot.getCachedProcess = originalGetCachedProcess;
+    Math.random = originalRandom;
+    jest.useRealTimers();
+  });
+
+  it('should keep at most maxConcurrent clients loading at once', async () => {
+    windows = new Map();
+    start(makeAccounts(4), 2, 5);
+
+    await jest.advanceTimersByTimeAsync(1000);
+    expect(manager.getRunningProcesses()).toHaveLength(2);
+
+    // Nobody became ready, so the next pair waits for launchDelay
+    await jest.advanceTimersByTimeAsync(3000);
+    expect(manager.getRunningProcesses()).toHaveLength(2);
+
+    await jest.advanceTimersByTimeAsync(3000);
+    expect(manager.getRunningProcesses()).toHaveLength(4);
+    expect(Math.max(...progress.map((update) => update.active.length))).toBe(2);
+  });
+
+  it('should release a slot as soon as its client opens a window', async () => {
+    windows = new Map();
+    start(makeAccounts(2), 1, 30);
+
+    await jest.advanceTimersByTimeAsync(2000);
+    expect(launched).toEqual(['testuser1']);
+
+    const [first] = manager.getRunningProcesses();
+    windows.set(first.pid, 'Perfect World');
+    await jest.advanceTimersByTimeAsync(2000);
+
+    expect(launched).toEqual(['testuser1', 'testuser2']);
+    expect(manager.getProcessInfo(first.accountId)?.pid).toBe(first.pid);
+  });
+
+  it('should stop queued launches when cancelled', async () => {
+    windows = new Map();
+    start(makeAccounts(3), 1, 30);
+
+    await jest.advanceTimersByTimeAsync(1000);
+    expect(scheduler.cancel('job-1')).toBe(true);
+    expect(scheduler.cancel('job-1')).toBe(false);
+    await jest.advanceTimersByTimeAsync(2000);
+
+    expect(launched).toEqual(['testuser1']);
+    expect(scheduler.hasActiveJobs()).toBe(false);
+    expect(last().state).toBe('cancelled');
+    expect(last().pending).toBe(0);
+  });
+
+  it('should skip accounts that are already running', async () => {
+    const accounts = makeAccounts(2);
+    const [running] = accounts;
+    void manager.launchGame(running, 'C:\\Games\\elementclient.exe');
+    await jest.advanceTimersByTimeAsync(100);
+
+    start(accounts, 1);
+    await jest.advanceTimersByTimeAsync(1000);
+
+    expect(launched).toEqual(['testuser1', 'testuser2']); // testuser1 only from the setup
+    expect(last()).toMatchObject({ state: 'completed', done: 2, failed: 0 });
+  });
+
+  it('should launch a smaller client first when the next one does not fit', async () => {
+    const [large, small] = makeAccounts(2);
+    monitor.usage = { ...monitor.usage, freeMemoryBytes: 8 * GB }; // 6.4 GB left under 90%
+    monitor.footprints.set(large.id, 8 * GB);
+    monitor.footprints.set(small.id, GB);
+
+    start([large, small], 1);
+    await jest.advanceTimersByTimeAsync(1000);
+    expect(launched).toEqual(['testuser2']);
+    expect(last().throttled).toBe('memory');
+
+    // Without headroom the large client still goes after the wait limit
+    await jest.advanceTimersByTimeAsync(125000);
+    expect(launched).toEqual(['testuser2', 'testuser1']);
+    expect(last()).toMatchObject({ state: 'completed', done: 2 });
+  });
+
+  it('should wait for CPU headroom before the next launch', async () => {
+    monitor.usage = { ...monitor.usage, cpuPercent: 95 };
+    start(makeAccounts(1), 1);
+
+    await jest.advanceTimersByTimeAsync(5000);
+    expect(launched).toEqual([]);
+    expect(last().throttled).toBe('cpu');
+
+    monitor.usage = { ...monitor.usage, cpuPercent: 40 };
+    await jest.advanceTimersByTimeAsync(3000);
+    expect(launched).toEqual(['testuser1']);
+    expect(last().throttled).toBeUndefined();
+  });
+});
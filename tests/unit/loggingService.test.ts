@@ -0,0 +1,52 @@
+// The log files live under app.getPath('userData'); each test file gets a scratch directory
+jest.mock('electron', () => {
+  const fs = require('fs');
+  const os = require('os');
+  const path = require('path');
+  const userData = fs.mkdtempSync(path.join(os.tmpdir(), 'pw-logs-'));
+  return { app: { getPath: () => userData } };
+});
+
+import * as fs from 'fs/promises';
+import * as path from 'path';
+import { app } from 'electron';
+import { logger, LogLevel } from '../../src/main/services/loggingService';
+
+describe('LoggingService', () => {
+  const userData = app.getPath('userData');
+  const exportPath = path.join(userData, 'export.log');
+
+  beforeAll(() => {
+    logger.setLogLevel(LogLevel.INFO);
+  });
+
+  afterAll(async () => {
+    await logger.clearLogs();
+    await fs.rm(userData, { recursive: true, force: true });
+  });
+
+  it('should export rotated history along with the live file', async () => {
+    const rotated = { i: 'old', t: Date.UTC(2024, 0, 1), l: LogLevel.INFO, m: 'Before rotation' };
+    await fs.writeFile(path.join(userData, 'app.ndjson.1.bak'), JSON.stringify(rotated) + '\n');
+    logger.info('After rotation', null, 'TEST');
+    await logger.flush();
+
+    await logger.exportLogs(exportPath);
+    const exported = await fs.readFile(exportPath, 'utf8');
+    expect(exported.indexOf('Before rotation')).toBeGreaterThanOrEqual(0);
+    expect(exported.indexOf('After rotation')).toBeGreaterThan(exported.indexOf('Before rotation'));
+  });
+
+  it('should export nothing after the logs are cleared', async () => {
+    await fs.writeFile(path.join(userData, 'app.ndjson.2.bak'), '');
+    logger.info('Cleared soon', null, 'TEST');
+    await logger.flush();
+
+    await logger.clearLogs();
+    await logger.exportLogs(exportPath);
+
+    expect(await fs.readFile(exportPath, 'utf8')).toBe('');
+    const remaining = (await fs.readdir(userData)).filter((name) => name.startsWith('app.'));
+    expect(remaining).toEqual([]);
+  });
+});
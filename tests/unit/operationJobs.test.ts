@@ -0,0 +1,46 @@
+import { OperationJobs } from '../../src/main/services/operationJobs';
+import { JobProgress } from '../../src/shared/types';
+
+const sleep = (ms: number) => new Promise((resolve) => setTimeout(resolve, ms));
+
+describe('OperationJobs', () => {
+  it('should coalesce progress within a window into one message', async () => {
+    const sent: JobProgress[] = [];
+    const jobs = new OperationJobs((progress) => sent.push(progress), 10);
+    const jobId = jobs.create('launch', 40);
+
+    for (let done = 1; done <= 20; done++) {
+      jobs.report(jobId, { done, pending: 40 - done });
+    }
+    await sleep(30);
+
+    expect(sent).toHaveLength(1);
+    expect(sent[0]).toMatchObject({ jobId, operation: 'launch', state: 'running', done: 20 });
+    jobs.destroy();
+  });
+
+  it('should send the final state at once and resolve waiters', async () => {
+    const sent: JobProgress[] = [];
+    const jobs = new OperationJobs((progress) => sent.push(progress), 1000);
+    const jobId = jobs.create('close', 3);
+    const outcome = jobs.wait(jobId);
+
+    jobs.report(jobId, { done: 1 });
+    jobs.report(jobId, { state: 'completed', done: 2, failed: 1, pending: 0 });
+
+    expect(sent).toHaveLength(1);
+    expect(await outcome).toMatchObject({ state: 'completed', done: 2, failed: 1 });
+    expect(await jobs.wait(jobId)).toMatchObject({ state: 'completed' });
+    jobs.destroy();
+  });
+
+  it('should resolve with the current state on timeout and null for unknown jobs', async () => {
+    const jobs = new OperationJobs(() => {}, 10);
+    const jobId = jobs.create('launch', 2);
+    jobs.report(jobId, { done: 1 });
+
+    expect(await jobs.wait(jobId, 20)).toMatchObject({ state: 'running', done: 1 });
+    expect(await jobs.wait('close-999')).toBeNull();
+    jobs.destroy();
+  });
+});
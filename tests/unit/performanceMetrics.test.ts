@@ -0,0 +1,47 @@
+import { PerformanceMetrics } from '../../src/main/services/performanceMetrics';
+
+describe('PerformanceMetrics', () => {
+  it('should report percentiles per operation', () => {
+    const metrics = new PerformanceMetrics();
+    for (let ms = 1; ms <= 100; ms++) {
+      metrics.record('process.snapshot', ms);
+    }
+    metrics.record('launch.spawn', 40);
+
+    const summary = metrics.getSummary();
+    expect(summary.operations.map((op) => op.name)).toEqual(['launch.spawn', 'process.snapshot']);
+    expect(summary.operations[1]).toMatchObject({ count: 100, p50Ms: 50, p95Ms: 95, maxMs: 100 });
+  });
+
+  it('should time async work and count events', async () => {
+    const metrics = new PerformanceMetrics();
+    const result = await metrics.time('launch.account', async () => {
+      await new Promise((resolve) => setTimeout(resolve, 20));
+      return 'ready';
+    });
+    metrics.increment('ipc.stateDelta');
+    metrics.increment('ipc.stateDelta', 2);
+
+    const summary = metrics.getSummary({ 'window-shown': 420 });
+    expect(result).toBe('ready');
+    expect(summary.operations[0].p50Ms).toBeGreaterThanOrEqual(15);
+    expect(summary.counters).toEqual({ 'ipc.stateDelta': 3 });
+    expect(summary.startup).toEqual({ 'window-shown': 420 });
+  });
+
+  it('should produce trace events for main and renderer spans', () => {
+    const metrics = new PerformanceMetrics({ traceCapacity: 10 });
+    const end = metrics.startSpan('launch.spawn', { account: 'testuser1' });
+    end({ pid: 1234 });
+    metrics.recordRendererTimings([
+      { name: 'ipc.get-accounts', startedAt: Date.now() - 5, durationMs: 5 },
+      { name: 'broken', startedAt: 0, durationMs: NaN },
+    ]);
+
+    const events = metrics.getTraceEvents().filter((event) => event.ph === 'X');
+    expect(events).toHaveLength(2);
+    expect(events[0]).toMatchObject({ name: 'launch.spawn', cat: 'launch', tid: 1 });
+    expect(events[0].args).toEqual({ account: 'testuser1', pid: 1234 });
+    expect(events[1]).toMatchObject({ name: 'ipc.get-accounts', tid: 2, dur: 5000 });
+  });
+});
@@ -0,0 +1,34 @@
+import { RingBuffer } from '../../src/shared/utils/ringBuffer';
+
+describe('RingBuffer', () => {
+  it('should keep items in insertion order until full', () => {
+    const buffer = new RingBuffer<number>(3);
+    expect(buffer.push(1)).toBeUndefined();
+    buffer.push(2);
+
+    expect(buffer.size).toBe(2);
+    expect(buffer.toArray()).toEqual([1, 2]);
+    expect(buffer.get(0)).toBe(1);
+    expect(buffer.get(2)).toBeUndefined();
+  });
+
+  it('should overwrite and return the oldest item once full', () => {
+    const buffer = new RingBuffer<number>(3);
+    [1, 2, 3].forEach((n) => buffer.push(n));
+
+    expect(buffer.push(4)).toBe(1);
+    expect(buffer.push(5)).toBe(2);
+    expect(buffer.size).toBe(3);
+    expect(buffer.toArray()).toEqual([3, 4, 5]);
+    expect(buffer.filter((n) => n % 2 === 1)).toEqual([3, 5]);
+  });
+
+  it('should start over after clear', () => {
+    const buffer = new RingBuffer<number>(2);
+    [1, 2, 3].forEach((n) => buffer.push(n));
+    buffer.clear();
+    buffer.push(9);
+
+    expect(buffer.toArray()).toEqual([9]);
+  });
+});
@@ -0,0 +1,72 @@
+import { SharedAssetCache } from '../../src/main/services/sharedAssetCache';
+
+// Just enough of an Electron session: records the https handler and answers fetches locally
+function createFakeSession(respond: (url: string) => Response) {
+  let handler: (request: Request) => Promise<Response> = async () => new Response(null);
+  const fetched: string[] = [];
+  const session = {
+    protocol: {
+      handle: (_scheme: string, fn: typeof handler) => {
+        handler = fn;
+      },
+    },
+    fetch: async (input: Request | string) => {
+      const url = typeof input === 'string' ? input : input.url;
+      fetched.push(url);
+      return respond(url);
+    },
+  };
+  return { session, fetched, request: (url: string) => handler(new Request(url)) };
+}
+
+describe('SharedAssetCache', () => {
+  it('should fetch a static asset once for every session', async () => {
+    const cache = new SharedAssetCache();
+    const first = createFakeSession(() => new Response('body{}', { status: 200 }));
+    const second = createFakeSession(() => new Response('body{}', { status: 200 }));
+    cache.attach(first.session as any);
+    cache.attach(second.session as any);
+
+    expect(await (await first.request('https://site/app.css')).text()).toBe('body{}');
+    expect(await (await second.request('https://site/app.css')).text()).toBe('body{}');
+
+    expect(first.fetched).toEqual(['https://site/app.css']);
+    expect(second.fetched).toEqual([]);
+    expect(cache.hits).toBe(1);
+  });
+
+  it('should not share pages or responses that set cookies', async () => {
+    const cache = new SharedAssetCache();
+    const fake = createFakeSession(
+      (url) =>
+        new Response('x', {
+          status: 200,
+          headers: url.endsWith('.js') ? { 'set-cookie': 'sid=1' } : {},
+        })
+    );
+    cache.attach(fake.session as any);
+
+    await fake.request('https://site/lk/');
+    await fake.request('https://site/lk/');
+    await fake.request('https://site/tracker.js');
+    await fake.request('https://site/tracker.js');
+
+    expect(fake.fetched.filter((url) => url.endsWith('/lk/'))).toHaveLength(2);
+    expect(fake.fetched.filter((url) => url.endsWith('.js')).length).toBeGreaterThanOrEqual(2);
+    expect(cache.size).toBe(0);
+  });
+
+  it('should evict the least recently used assets beyond its budget', async () => {
+    const cache = new SharedAssetCache(800);
+    const fake = createFakeSession(() => new Response('a'.repeat(100), { status: 200 }));
+    cache.attach(fake.session as any);
+
+    for (let i = 0; i < 10; i++) {
+      await fake.request(`https://site/${i}.png`);
+    }
+
+    expect(cache.size).toBeLessThanOrEqual(800);
+    await fake.request('https://site/0.png');
+    expect(fake.fetched.filter((url) => url.endsWith('/0.png'))).toHaveLength(2);
+  });
+});
@@ -0,0 +1,55 @@
+import { TtlCache } from '../../src/shared/utils/ttlCache';
+
+describe('TtlCache', () => {
+  it('should return values before they expire', () => {
+    const cache = new TtlCache<number, boolean>(1000);
+    cache.set(1, true);
+    cache.set(2, false);
+
+    expect(cache.get(1)).toBe(true);
+    expect(cache.get(2)).toBe(false);
+    expect(cache.has(2)).toBe(true);
+    expect(cache.size).toBe(2);
+  });
+
+  it('should return undefined for missing keys', () => {
+    const cache = new TtlCache<number, boolean>(1000);
+    expect(cache.get(42)).toBeUndefined();
+    expect(cache.has(42)).toBe(false);
+  });
+
+  it('should expire entries after their ttl', async () => {
+    const cache = new TtlCache<number, string>(1000);
+    cache.set(1, 'short', 20);
+    cache.set(2, 'long');
+
+    await new Promise((resolve) => setTimeout(resolve, 50));
+
+    expect(cache.get(1)).toBeUndefined();
+    expect(cache.get(2)).toBe('long');
+    expect(cache.size).toBe(1);
+  });
+
+  it('should refresh expiry when a key is set again', async () => {
+    const cache = new TtlCache<number, string>(40);
+    cache.set(1, 'first');
+
+    await new Promise((resolve) => setTimeout(resolve, 25));
+    cache.set(1, 'second');
+    await new Promise((resolve) => setTimeout(resolve, 25));
+
+    expect(cache.get(1)).toBe('second');
+  });
+
+  it('should delete and clear entries', () => {
+    const cache = new TtlCache<string, number>(1000);
+    cache.set('a', 1);
+    cache.set('b', 2);
+
+    expect(cache.delete('a')).toBe(true);
+    expect(cache.get('a')).toBeUndefined();
+
+    cache.clear();
+    expect(cache.size).toBe(0);
+  });
+});
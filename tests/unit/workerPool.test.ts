@@ -0,0 +1,126 @@
+import * as fs from 'fs/promises';
+import * as os from 'os';
+import * as path from 'path';
+import { WorkerPool } from '../../src/main/services/workerPool';
+
+// Speaks the pool's protocol without needing the compiled TypeScript worker: parseBatchFile
+// answers with the byte count it received, exportLogs runs until it is cancelled
+const launcher = (login: string) =>
+  new TextEncoder().encode(
+    `@echo off\r\nstart "" "elementclient.exe" startbypatcher user:${login} pwd:secret\r\n`
+  );
+
+const STUB_WORKER = `
+const { parentPort } = require('worker_threads');
+const running = new Map();
+parentPort.on('message', (request) => {
+  if (request.type === 'cancel') {
+    clearInterval(running.get(request.id));
+    parentPort.postMessage({
+      type: 'error',
+      id: request.id,
+      error: { name: 'AbortError', message: 'The operation was aborted' },
+    });
+    return;
+  }
+  if (request.task === 'parseBatchFile') {
+    parentPort.postMessage({ type: 'progress', id: request.id, progress: 'started' });
+    const login = String(request.input.bytes.byteLength);
+    parentPort.postMessage({ type: 'result', id: request.id, result: { login } });
+  } else {
+    running.set(request.id, setInterval(() => undefined, 1000));
+  }
+});
+parentPort.postMessage({ type: 'ready' });
+`;
+
+describe('WorkerPool', () => {
+  let dir: string;
+  let stubPath: string;
+
+  beforeAll(async () => {
+    dir = await fs.mkdtemp(path.join(os.tmpdir(), 'pw-workers-'));
+    stubPath = path.join(dir, 'stubWorker.js');
+    await fs.writeFile(stubPath, STUB_WORKER);
+  });
+
+  afterAll(async () => {
+    await fs.rm(dir, { recursive: true, force: true });
+  });
+
+  it('should run tasks inline when there is no worker script', async () => {
+    const pool = new WorkerPool({ script: null });
+    const account = await pool.run('parseBatchFile', { bytes: launcher('alpha') });
+    expect(pool.inline).toBe(true);
+    expect(account.login).toBe('alpha');
+    await pool.destroy();
+  });
+
+  it('should report progress from inline account file parsing', async () => {
+    const pool = new WorkerPool({ script: null });
+    const csvPath = path.join(dir, 'accounts.csv');
+    await fs.writeFile(csvPath, 'login,password,server\nalpha,secret,Main\nbeta,secret,X\n');
+    const progress: number[] = [];
+
+    const accounts = await pool.run(
+      'parseAccountFile',
+      { filePath: csvPath, format: 'csv' },
+      { onProgress: (update) => progress.push(update.accounts) }
+    );
+    expect(accounts.map((account) => account.login)).toEqual(['alpha', 'beta']);
+    expect(progress[progress.length - 1]).toBe(2);
+    await pool.destroy();
+  });
+
+  it('should move transferred buffers to the worker thread', async () => {
+    const pool = new WorkerPool({ script: stubPath, size: 2 });
+    const bytes = new Uint8Array(1024);
+    const updates: unknown[] = [];
+
+    const result = await pool.run(
+      'parseBatchFile',
+      { bytes },
+      { transfer: [bytes.buffer], onProgress: (update) => updates.push(update) }
+    );
+    expect(pool.inline).toBe(false);
+    expect(result.login).toBe('1024');
+    expect(bytes.byteLength).toBe(0); // Detached here
+    expect(updates).toEqual(['started']);
+    await pool.destroy();
+  });
+
+  it('should cancel a running task', async () => {
+    const pool = new WorkerPool({ script: stubPath, size: 1 });
+    const controller = new AbortController();
+
+    const running = pool.run(
+      'exportLogs',
+      { outputPath: path.join(dir, 'out.log'), sources: [] },
+      { signal: controller.signal }
+    );
+    const queued = pool.run('parseBatchFile', { bytes: new Uint8Array(8) });
+    setTimeout(() => controller.abort(), 50);
+
+    await expect(running).rejects.toThrow('aborted');
+    // The worker is free again for the next task
+    expect((await queued).login).toBe('8');
+    await pool.destroy();
+  });
+
+  it('should fall back to inline when the worker cannot start', async () => {
+    const brokenPath = path.join(dir, 'brokenWorker.js');
+    await fs.writeFile(brokenPath, 'throw new Error("cannot load");');
+    const pool = new WorkerPool({ script: brokenPath });
+    const originalWarn = console.warn;
+    console.warn = () => undefined;
+
+    try {
+      const account = await pool.run('parseBatchFile', { bytes: launcher('beta') });
+      expect(account.login).toBe('beta');
+      expect(pool.inline).toBe(true);
+    } finally {
+      console.warn = originalWarn;
+      await pool.destroy();
+    }
+  });
+});